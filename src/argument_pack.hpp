@@ -0,0 +1,93 @@
+#ifndef __RPC_ARGUMENT_PACK_H__
+#define __RPC_ARGUMENT_PACK_H__
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rpc {
+    // 参数包：在固定容量的内联缓冲区中直接构造 std::tuple<Args...>，
+    // 只有参数元组本身超过容量时才退回堆分配。
+    // 解码器按参数下标直接写入对应的槽位，调用时再把各槽位移动给处理函数。
+    //
+    // 每个参数包带一个单调分配区：pmr 参数（std::pmr::string、std::pmr::vector 等）
+    // 从中分配，处理函数返回、参数元组析构后整体释放，请求路径上不再逐个 malloc/free。
+    // 处理函数不能让 pmr 参数（或从参数移出的值）比这次调用活得更久。
+    class ArgumentPack {
+    public:
+        static constexpr size_t inline_capacity = 256;
+        static constexpr size_t arena_capacity = 1024;
+
+        ArgumentPack() = default;
+        ArgumentPack(const ArgumentPack&) = delete;
+        ArgumentPack& operator=(const ArgumentPack&) = delete;
+
+        ~ArgumentPack() { reset(); }
+
+        // 构造默认初始化的参数元组，替换之前的内容
+        template<typename Tuple>
+        Tuple& emplace() {
+            reset();
+            if constexpr (fits_inline<Tuple>()) {
+                storage_ = new (buffer_) Tuple();
+                destroy_ = [](void* p) { static_cast<Tuple*>(p)->~Tuple(); };
+            } else {
+                storage_ = new Tuple();
+                destroy_ = [](void* p) { delete static_cast<Tuple*>(p); };
+            }
+            return *static_cast<Tuple*>(storage_);
+        }
+
+        template<typename Tuple>
+        Tuple& get() { return *static_cast<Tuple*>(storage_); }
+
+        // 按注册时记录的偏移量取得参数槽位
+        void* slot(size_t offset) { return static_cast<char*>(storage_) + offset; }
+
+        bool empty() const { return storage_ == nullptr; }
+
+        // 本次调用的分配区；内联缓冲区用完后才向默认资源申请更大的块
+        std::pmr::memory_resource* arena() { return &arena_; }
+
+        // 析构参数元组后释放分配区中的全部内存
+        void reset() {
+            if (storage_) {
+                destroy_(storage_);
+                storage_ = nullptr;
+                destroy_ = nullptr;
+            }
+            arena_.release();
+        }
+
+        template<typename Tuple>
+        static constexpr bool fits_inline() {
+            return sizeof(Tuple) <= inline_capacity && alignof(Tuple) <= alignof(std::max_align_t);
+        }
+
+        // 计算元组中每个元素相对于元组起始地址的偏移量（注册时调用一次）
+        template<typename Tuple>
+        static std::vector<size_t> slot_offsets() {
+            return slot_offsets_impl<Tuple>(std::make_index_sequence<std::tuple_size_v<Tuple>>{});
+        }
+
+    private:
+        template<typename Tuple, size_t... I>
+        static std::vector<size_t> slot_offsets_impl(std::index_sequence<I...>) {
+            Tuple sample{};
+            const char* base = reinterpret_cast<const char*>(&sample);
+            return {static_cast<size_t>(reinterpret_cast<const char*>(&std::get<I>(sample)) - base)...};
+        }
+
+        alignas(std::max_align_t) unsigned char buffer_[inline_capacity];
+        void* storage_ = nullptr;
+        void (*destroy_)(void*) = nullptr;
+        alignas(std::max_align_t) unsigned char arena_buffer_[arena_capacity];
+        std::pmr::monotonic_buffer_resource arena_{arena_buffer_, arena_capacity};
+    };
+}
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef __RPC_BYTE_ORDER_H__
+#define __RPC_BYTE_ORDER_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define RPC_BYTE_ORDER_X86 1
+#else
+#define RPC_BYTE_ORDER_X86 0
+#endif
+
+namespace rpc {
+namespace serialization {
+    enum class ByteOrder : uint8_t { LITTLE, BIG };
+
+    inline constexpr ByteOrder host_byte_order =
+        __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__ ? ByteOrder::BIG : ByteOrder::LITTLE;
+
+    // 线路字节序固定为小端：所有定长整数、浮点数和长度前缀都按小端写入
+    inline constexpr ByteOrder wire_byte_order = ByteOrder::LITTLE;
+
+    // 本机与线路字节序不同时才需要交换；小端主机上所有转换都退化为 memcpy
+    inline constexpr bool wire_needs_swap = host_byte_order != wire_byte_order;
+
+    namespace byte_order {
+        template<typename T>
+        T byteswap(T value) {
+            static_assert(std::is_trivially_copyable_v<T>, "byteswap requires a trivially copyable type");
+            if constexpr (sizeof(T) == 1) {
+                return value;
+            } else {
+                using U = std::conditional_t<sizeof(T) == 2, uint16_t,
+                          std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>;
+                static_assert(sizeof(T) == sizeof(U), "Unsupported size for byteswap");
+                U bits;
+                std::memcpy(&bits, &value, sizeof(T));
+                if constexpr (sizeof(U) == 2) bits = __builtin_bswap16(bits);
+                else if constexpr (sizeof(U) == 4) bits = __builtin_bswap32(bits);
+                else bits = __builtin_bswap64(bits);
+                std::memcpy(&value, &bits, sizeof(T));
+                return value;
+            }
+        }
+
+        // 逐个元素交换字节序（标量回退路径，支持 dst == src）
+        inline void swap_copy_scalar(uint8_t* dst, const uint8_t* src, size_t count, size_t element_size) {
+            uint8_t element[8];
+            for (size_t i = 0; i < count; ++i) {
+                std::memcpy(element, src + i * element_size, element_size);
+                for (size_t b = 0; b < element_size; ++b) {
+                    dst[i * element_size + b] = element[element_size - 1 - b];
+                }
+            }
+        }
+
+#if RPC_BYTE_ORDER_X86
+        // pshufb 的字节重排表：每个 element_size 字节的元素内部倒序
+        inline __m128i swap_mask(size_t element_size) {
+            alignas(16) uint8_t mask[16];
+            for (size_t i = 0; i < 16; ++i) {
+                mask[i] = static_cast<uint8_t>((i / element_size) * element_size + element_size - 1 - i % element_size);
+            }
+            return _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+        }
+
+        // 返回已处理的字节数，剩余部分由调用方处理
+        __attribute__((target("ssse3")))
+        inline size_t swap_copy_ssse3(uint8_t* dst, const uint8_t* src, size_t bytes, size_t element_size) {
+            const __m128i mask = swap_mask(element_size);
+            size_t done = 0;
+            for (; done + 16 <= bytes; done += 16) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + done));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + done), _mm_shuffle_epi8(v, mask));
+            }
+            return done;
+        }
+
+        // vpshufb 在两个 128 位通道内分别重排，同一张表复制到两个通道即可
+        __attribute__((target("avx2")))
+        inline size_t swap_copy_avx2(uint8_t* dst, const uint8_t* src, size_t bytes, size_t element_size) {
+            const __m128i half = swap_mask(element_size);
+            const __m256i mask = _mm256_broadcastsi128_si256(half);
+            size_t done = 0;
+            for (; done + 32 <= bytes; done += 32) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + done));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + done), _mm256_shuffle_epi8(v, mask));
+            }
+            return done;
+        }
+
+        enum class SimdLevel { NONE, SSSE3, AVX2 };
+
+        inline SimdLevel simd_level() {
+            static const SimdLevel level = [] {
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+                if (__builtin_cpu_supports("ssse3")) return SimdLevel::SSSE3;
+                return SimdLevel::NONE;
+            }();
+            return level;
+        }
+#endif
+
+        // 把 count 个 element_size 字节的元素逐个倒序复制到 dst（dst 与 src 可以相同）。
+        // 按运行时检测到的指令集选择 AVX2 / SSSE3 pshufb，其余字节走标量路径
+        inline void swap_copy(void* dst, const void* src, size_t count, size_t element_size) {
+            uint8_t* out = static_cast<uint8_t*>(dst);
+            const uint8_t* in = static_cast<const uint8_t*>(src);
+            if (element_size <= 1) {
+                if (out != in) std::memmove(out, in, count * element_size);
+                return;
+            }
+            size_t bytes = count * element_size;
+            size_t done = 0;
+#if RPC_BYTE_ORDER_X86
+            switch (simd_level()) {
+                case SimdLevel::AVX2: done = swap_copy_avx2(out, in, bytes, element_size); break;
+                case SimdLevel::SSSE3: done = swap_copy_ssse3(out, in, bytes, element_size); break;
+                case SimdLevel::NONE: break;
+            }
+#endif
+            swap_copy_scalar(out + done, in + done, (bytes - done) / element_size, element_size);
+        }
+
+        // 本机数组 -> 线路字节序
+        template<typename T>
+        void to_wire(void* dst, const T* src, size_t count) {
+            if constexpr (wire_needs_swap && sizeof(T) > 1) {
+                swap_copy(dst, src, count, sizeof(T));
+            } else {
+                std::memcpy(dst, src, count * sizeof(T));
+            }
+        }
+
+        // 线路字节序 -> 本机数组
+        template<typename T>
+        void from_wire(T* dst, const void* src, size_t count) {
+            if constexpr (wire_needs_swap && sizeof(T) > 1) {
+                swap_copy(dst, src, count, sizeof(T));
+            } else {
+                std::memcpy(dst, src, count * sizeof(T));
+            }
+        }
+
+        template<typename T>
+        void store(void* dst, T value) {
+            if constexpr (wire_needs_swap) {
+                value = byteswap(value);
+            }
+            std::memcpy(dst, &value, sizeof(T));
+        }
+
+        template<typename T>
+        T load(const void* src) {
+            T value;
+            std::memcpy(&value, src, sizeof(T));
+            if constexpr (wire_needs_swap) {
+                value = byteswap(value);
+            }
+            return value;
+        }
+    }
+}
+}
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef __RPC_COMPLETION_QUEUE_H__
+#define __RPC_COMPLETION_QUEUE_H__
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace rpc {
+namespace net {
+    // 工作线程把完成的响应帧交回事件循环：入队后写 eventfd 唤醒循环，循环线程 drain() 取走。
+    // 由 shared_ptr 共享，连接或事件循环销毁后才完成的调用只会在 close() 之后被丢弃
+    class CompletionQueue {
+    public:
+        struct Completion {
+            uint64_t connection;
+            std::vector<uint8_t> frame;
+        };
+
+        explicit CompletionQueue(int wakeup_fd) : wakeup_fd_(wakeup_fd) {}
+
+        // 可以在任意线程调用；队列由空变为非空时才唤醒
+        void push(uint64_t connection, std::vector<uint8_t> frame) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (closed_) {
+                return;
+            }
+            bool was_empty = items_.empty();
+            items_.push_back(Completion{connection, std::move(frame)});
+            if (was_empty) {
+                uint64_t one = 1;
+                ssize_t written = write(wakeup_fd_, &one, sizeof(one));
+                (void)written;
+            }
+        }
+
+        // 在事件循环线程上取走全部完成的响应
+        template<typename Handler>
+        void drain(Handler handler) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                draining_.swap(items_);
+            }
+            for (auto& item : draining_) {
+                handler(item.connection, item.frame);
+            }
+            draining_.clear();
+        }
+
+        // 事件循环关闭 eventfd 之前调用，之后的 push() 直接丢弃
+        void close() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+            items_.clear();
+        }
+
+    private:
+        int wakeup_fd_;
+        std::mutex mutex_;
+        bool closed_ = false;
+        std::vector<Completion> items_;
+        std::vector<Completion> draining_;
+    };
+}
+}
+
+#endif
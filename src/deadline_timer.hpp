@@ -0,0 +1,106 @@
+#ifndef __RPC_DEADLINE_TIMER_H__
+#define __RPC_DEADLINE_TIMER_H__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace rpc {
+    // 单线程定时器：到期时在定时器线程上执行回调。线程在第一次 schedule() 时启动，
+    // 析构时丢弃尚未到期的回调
+    class DeadlineTimer {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using Callback = std::function<void()>;
+
+        struct Handle {
+            Clock::time_point deadline;
+            uint64_t id = 0;
+        };
+
+        DeadlineTimer() = default;
+
+        DeadlineTimer(const DeadlineTimer&) = delete;
+        DeadlineTimer& operator=(const DeadlineTimer&) = delete;
+
+        ~DeadlineTimer() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            cv_.notify_one();
+            if (thread_.joinable()) {
+                thread_.join();
+            }
+        }
+
+        // 先分配句柄再 schedule()：句柄可以在回调登记之前交给其他线程用于 cancel()
+        Handle make_handle(Clock::time_point deadline) {
+            return Handle{deadline, next_id_.fetch_add(1, std::memory_order_relaxed) + 1};
+        }
+
+        void schedule(const Handle& handle, Callback callback) {
+            bool earliest;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!thread_.joinable()) {
+                    thread_ = std::thread([this]() { run(); });
+                }
+                auto it = entries_.emplace(std::make_pair(handle.deadline, handle.id), std::move(callback)).first;
+                earliest = it == entries_.begin();
+            }
+            if (earliest) {
+                cv_.notify_one();
+            }
+        }
+
+        // 取消尚未到期的回调；已经执行或尚未登记的句柄忽略
+        void cancel(const Handle& handle) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            entries_.erase(std::make_pair(handle.deadline, handle.id));
+        }
+
+        size_t pending() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return entries_.size();
+        }
+
+    private:
+        std::map<std::pair<Clock::time_point, uint64_t>, Callback> entries_;
+        std::atomic<uint64_t> next_id_{0};
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        std::thread thread_;
+        bool stopping_ = false;
+
+        void run() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (!stopping_) {
+                if (entries_.empty()) {
+                    cv_.wait(lock);
+                    continue;
+                }
+                auto first = entries_.begin();
+                // 复制到期时间：等待期间该条目可能被 cancel() 删除
+                Clock::time_point deadline = first->first.first;
+                if (Clock::now() < deadline) {
+                    cv_.wait_until(lock, deadline);
+                    continue;
+                }
+                Callback callback = std::move(first->second);
+                entries_.erase(first);
+                lock.unlock();
+                callback();
+                lock.lock();
+            }
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,335 @@
+#ifndef __RPC_EPOLL_LOOP_H__
+#define __RPC_EPOLL_LOOP_H__
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "completion_queue.hpp"
+#include "event_loop.hpp"
+#include "rpc_provider.hpp"
+#include "server_session.hpp"
+#include "unix_socket.hpp"
+
+namespace rpc {
+namespace net {
+    // 边沿触发的 epoll 事件循环：拥有一个监听套接字和它接受的所有连接，只在自己的线程上运行。
+    // 线程池中完成的调用经 CompletionQueue 和 eventfd 交回本线程发送。
+    // 监听 Unix 域套接字时用 recvmsg 读取，接收随请求帧传来的负载描述符
+    class EpollLoop : public EventLoop {
+    public:
+        EpollLoop(RpcProvider& provider, const ServerOptions& options, int listen_fd)
+            : provider_(provider), max_frame_bytes_(options.max_frame_bytes), max_in_flight_(options.max_in_flight),
+              max_pending_output_(options.max_pending_output), listen_fd_(listen_fd), unix_socket_(!options.unix_path.empty()) {
+            epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+            wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            spare_fd_ = open("/dev/null", O_RDONLY | O_CLOEXEC);
+            if (epoll_fd_ < 0 || wakeup_fd_ < 0) {
+                release();
+                throw_errno("epoll_create1/eventfd");
+            }
+            completions_ = std::make_shared<CompletionQueue>(wakeup_fd_);
+            add(listen_fd_, EPOLLIN | EPOLLET, this);
+            add(wakeup_fd_, EPOLLIN, &wakeup_fd_);
+        }
+
+        EpollLoop(const EpollLoop&) = delete;
+        EpollLoop& operator=(const EpollLoop&) = delete;
+
+        ~EpollLoop() override { release(); }
+
+        // 运行直到 stop() 被调用
+        void run() override {
+            epoll_event events[128];
+            while (!stopping_.load(std::memory_order_acquire)) {
+                int count = epoll_wait(epoll_fd_, events, 128, -1);
+                if (count < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    break;
+                }
+                for (int i = 0; i < count; ++i) {
+                    void* tag = events[i].data.ptr;
+                    if (tag == &wakeup_fd_) {
+                        deliver_completions();
+                        continue;
+                    }
+                    if (tag == this) {
+                        accept_all();
+                        continue;
+                    }
+                    Connection& connection = *static_cast<Connection*>(tag);
+                    if (connection.closing) {
+                        continue;
+                    }
+                    uint32_t flags = events[i].events;
+                    if (flags & (EPOLLRDHUP | EPOLLHUP)) {
+                        connection.hangup = true;
+                    }
+                    if (flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                        if (!on_readable(connection)) {
+                            close_connection(connection);
+                            continue;
+                        }
+                    }
+                    if (flags & EPOLLOUT) {
+                        // 积压的响应发出后可能解除暂停，继续处理缓冲的请求和读取
+                        bool open = connection.read_paused ? on_readable(connection)
+                                                           : flush(connection) && !finished(connection);
+                        if (!open) {
+                            close_connection(connection);
+                        }
+                    }
+                }
+                reap_closed();
+            }
+        }
+
+        // 可以在任意线程调用
+        void stop() override {
+            stopping_.store(true, std::memory_order_release);
+            uint64_t one = 1;
+            ssize_t written = write(wakeup_fd_, &one, sizeof(one));
+            (void)written;
+        }
+
+    private:
+        struct Connection {
+            uint64_t id;
+            int fd;
+            ServerSession session;
+            bool closing = false;
+            // 因未完成的调用过多停止了读取，套接字中可能还有数据
+            bool read_paused = false;
+            // 对端已关闭写方向：不再读取，未完成的调用应答并发出后再关闭
+            bool peer_closed = false;
+            // 收到过 EPOLLRDHUP：FIN 排在剩余数据之后，短读不代表读空，要读到 0 为止
+            bool hangup = false;
+        };
+
+        RpcProvider& provider_;
+        size_t max_frame_bytes_;
+        size_t max_in_flight_;
+        size_t max_pending_output_;
+        int listen_fd_;
+        bool unix_socket_;
+        int epoll_fd_ = -1;
+        int wakeup_fd_ = -1;
+        // 预留的描述符：描述符用尽时释放它来接受并关闭排队的连接
+        int spare_fd_ = -1;
+        std::atomic<bool> stopping_{false};
+        // 以递增编号而不是 fd 为键：连接关闭后 fd 会被复用，迟到的响应不能送错连接
+        std::unordered_map<uint64_t, std::unique_ptr<Connection>> connections_;
+        uint64_t next_connection_id_ = 0;
+        std::shared_ptr<CompletionQueue> completions_;
+        std::vector<uint64_t> completed_;
+        // 本轮已关闭的连接：同一批事件中后面的条目可能仍指向它们，整批处理完才释放
+        std::vector<uint64_t> closed_;
+
+        void add(int fd, uint32_t events, void* tag) {
+            epoll_event event{};
+            event.events = events;
+            event.data.ptr = tag;
+            if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+                throw_errno("epoll_ctl");
+            }
+        }
+
+        void accept_all() {
+            while (true) {
+                int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                if (fd < 0) {
+                    if (errno == EINTR || errno == ECONNABORTED) {
+                        continue;
+                    }
+                    // 边沿触发：不接受掉排队的连接就不会再有事件，它们会一直卡在队列中。
+                    // 用预留的描述符接受并立即关闭，对端至少能看到连接被关闭
+                    if ((errno == EMFILE || errno == ENFILE) && spare_fd_ >= 0) {
+                        close(spare_fd_);
+                        int rejected = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+                        if (rejected >= 0) {
+                            close(rejected);
+                        }
+                        spare_fd_ = open("/dev/null", O_RDONLY | O_CLOEXEC);
+                        if (rejected >= 0) {
+                            continue;
+                        }
+                    }
+                    // EAGAIN：已接受完
+                    return;
+                }
+                if (!unix_socket_) {
+                    set_nodelay(fd);
+                }
+                uint64_t id = ++next_connection_id_;
+                auto connection = std::make_unique<Connection>(Connection{id, fd, ServerSession(provider_, max_frame_bytes_)});
+                connection->session.enable_async(completions_, id, max_in_flight_);
+                connection->session.limit_output(max_pending_output_);
+                epoll_event event{};
+                event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+                event.data.ptr = connection.get();
+                if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+                    close(fd);
+                    continue;
+                }
+                connections_.emplace(id, std::move(connection));
+            }
+        }
+
+        // 读到 EAGAIN 为止，处理完整的请求并尽量发送响应；连接应关闭时返回 false。
+        // 未完成的调用达到上限或积压的响应过多时停止读取，剩余数据留在内核中，
+        // 由 deliver_completions() 或 EPOLLOUT 恢复后再读
+        bool on_readable(Connection& connection) {
+            bool drained = connection.peer_closed;
+            connection.read_paused = false;
+            while (true) {
+                if (!connection.session.process()) {
+                    return false;
+                }
+                if (connection.session.paused()) {
+                    if (!flush(connection)) {
+                        return false;
+                    }
+                    if (!connection.session.paused()) {
+                        continue;
+                    }
+                    // 边沿触发：没有读到 EAGAIN，不会再有新的事件，由 deliver_completions() 或 EPOLLOUT 负责继续读
+                    connection.read_paused = !drained;
+                    break;
+                }
+                if (drained) {
+                    break;
+                }
+                span<uint8_t> space = connection.session.read_space();
+                ssize_t n;
+                if (unix_socket_) {
+                    bool accepted = true;
+                    n = receive_with_descriptors(connection.fd, space, [&](int fd) {
+                        accepted = connection.session.push_descriptor(fd) && accepted;
+                    });
+                    if (!accepted) {
+                        return false;
+                    }
+                } else {
+                    n = read(connection.fd, space.data(), space.size());
+                }
+                if (n > 0) {
+                    connection.session.commit_read(static_cast<size_t>(n));
+                    // TCP 短读说明内核缓冲区已读空，之后到达的数据会触发新的边沿；
+                    // Unix 域套接字的 recvmsg 会在带描述符的数据段处提前返回，必须读到 EAGAIN
+                    drained = !unix_socket_ && !connection.hangup && static_cast<size_t>(n) < space.size();
+                } else if (n == 0) {
+                    connection.peer_closed = true;
+                    drained = true;
+                } else if (errno == EINTR) {
+                    continue;
+                } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    drained = true;
+                } else {
+                    return false;
+                }
+            }
+            return flush(connection) && !finished(connection);
+        }
+
+        // 对端已半关闭，所有请求都已应答并发出
+        static bool finished(const Connection& connection) {
+            return connection.peer_closed && connection.session.in_flight() == 0 && !connection.session.has_output();
+        }
+
+        // 发送到 EAGAIN 为止，剩余数据等待 EPOLLOUT
+        bool flush(Connection& connection) {
+            while (connection.session.has_output()) {
+                ByteSpan pending = connection.session.pending_output();
+                ssize_t n = send(connection.fd, pending.data(), pending.size(), MSG_NOSIGNAL);
+                if (n > 0) {
+                    connection.session.consume_output(static_cast<size_t>(n));
+                } else if (n < 0 && errno == EINTR) {
+                    continue;
+                } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                    return true;
+                } else {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // 把完成的响应追加到各自的连接，继续处理因未完成调用过多而暂停的请求和读取，然后发送
+        void deliver_completions() {
+            uint64_t count;
+            ssize_t n = read(wakeup_fd_, &count, sizeof(count));
+            (void)n;
+            completions_->drain([this](uint64_t id, const std::vector<uint8_t>& frame) {
+                auto it = connections_.find(id);
+                if (it != connections_.end() && !it->second->closing) {
+                    it->second->session.complete(frame);
+                    completed_.push_back(id);
+                }
+            });
+            std::sort(completed_.begin(), completed_.end());
+            completed_.erase(std::unique(completed_.begin(), completed_.end()), completed_.end());
+            for (uint64_t id : completed_) {
+                auto it = connections_.find(id);
+                if (it == connections_.end() || it->second->closing) {
+                    continue;
+                }
+                Connection& connection = *it->second;
+                bool open = connection.read_paused && !connection.session.paused()
+                                ? on_readable(connection)
+                                : connection.session.process() && flush(connection) && !finished(connection);
+                if (!open) {
+                    close_connection(connection);
+                }
+            }
+            completed_.clear();
+        }
+
+        // 立即关闭套接字，Connection 留到 reap_closed() 再释放
+        void close_connection(Connection& connection) {
+            if (connection.closing) {
+                return;
+            }
+            connection.closing = true;
+            epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, connection.fd, nullptr);
+            close(connection.fd);
+            closed_.push_back(connection.id);
+        }
+
+        void reap_closed() {
+            for (uint64_t id : closed_) {
+                connections_.erase(id);
+            }
+            closed_.clear();
+        }
+
+        void release() {
+            if (completions_) {
+                completions_->close();
+            }
+            for (auto& entry : connections_) {
+                if (!entry.second->closing) {
+                    close(entry.second->fd);
+                }
+            }
+            connections_.clear();
+            if (listen_fd_ >= 0) close(listen_fd_);
+            if (wakeup_fd_ >= 0) close(wakeup_fd_);
+            if (epoll_fd_ >= 0) close(epoll_fd_);
+            if (spare_fd_ >= 0) close(spare_fd_);
+            listen_fd_ = wakeup_fd_ = epoll_fd_ = spare_fd_ = -1;
+        }
+    };
+}
+}
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef __RPC_EVENT_LOOP_H__
+#define __RPC_EVENT_LOOP_H__
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <system_error>
+
+namespace rpc {
+    // I/O 后端
+    enum class IoEngine {
+        AUTO,       // 内核支持时使用 io_uring，否则使用 epoll
+        EPOLL,
+        IO_URING    // 内核不支持时 RpcServer::start() 抛出 std::system_error
+    };
+
+    // 服务器配置
+    struct ServerOptions {
+        std::string host = "0.0.0.0";
+        uint16_t port = 0;                          // 0 表示由系统分配，启动后通过 RpcServer::port() 查询
+        size_t loop_count = 0;                      // 事件循环个数，0 表示 CPU 核数
+        bool pin_loops = false;                     // 第 i 个事件循环线程绑定到第 i 个 CPU 核
+        int backlog = 1024;
+        size_t max_frame_bytes = 64 * 1024 * 1024;  // 超过此长度的请求帧直接断开连接
+        size_t max_in_flight = 256;                 // 每个连接同时在线程池中执行的请求数上限，超过时暂缓处理后续请求
+        size_t max_pending_output = 4 * 1024 * 1024; // 每个连接积压的未发送响应超过此字节数时暂缓处理后续请求
+        std::string unix_path;                      // 非空时监听该路径的 Unix 域套接字而不是 TCP（只用 epoll，一个事件循环）
+        IoEngine io_engine = IoEngine::AUTO;
+        unsigned uring_entries = 256;               // io_uring 提交队列深度
+        unsigned uring_buffer_count = 256;          // 提供给内核的接收缓冲区个数（2 的幂）
+        unsigned uring_buffer_size = 16 * 1024;     // 每个接收缓冲区的大小
+    };
+
+    namespace net {
+        // 每个事件循环运行在自己的线程上，stop() 可以在任意线程调用
+        class EventLoop {
+        public:
+            virtual ~EventLoop() = default;
+            virtual void run() = 0;
+            virtual void stop() = 0;
+        };
+
+        [[noreturn]] inline void throw_errno(const char* what) {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        inline sockaddr_in make_address(const std::string& host, uint16_t port) {
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(port);
+            if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+                throw std::system_error(EINVAL, std::generic_category(), "Invalid IPv4 address: " + host);
+            }
+            return address;
+        }
+
+        // 非阻塞监听套接字。所有事件循环用 SO_REUSEPORT 绑定同一端口，由内核按连接分片
+        inline int open_listener(const ServerOptions& options, uint16_t port) {
+            int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            if (fd < 0) {
+                throw_errno("socket");
+            }
+            int one = 1;
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) < 0) {
+                close(fd);
+                throw_errno("setsockopt(SO_REUSEPORT)");
+            }
+            sockaddr_in address = make_address(options.host, port);
+            if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+                close(fd);
+                throw_errno("bind");
+            }
+            if (listen(fd, options.backlog) < 0) {
+                close(fd);
+                throw_errno("listen");
+            }
+            return fd;
+        }
+
+        inline uint16_t local_port(int fd) {
+            sockaddr_in address{};
+            socklen_t length = sizeof(address);
+            if (getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) < 0) {
+                throw_errno("getsockname");
+            }
+            return ntohs(address.sin_port);
+        }
+
+        inline void set_nodelay(int fd) {
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+    }
+}
+
+#endif
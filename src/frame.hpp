@@ -0,0 +1,104 @@
+#ifndef __RPC_FRAME_H__
+#define __RPC_FRAME_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include "byte_order.hpp"
+#include "serialization.hpp"
+#include "span.hpp"
+
+// 网络帧格式（所有整数为小端）：
+//
+//   帧       := uint32 负载长度 | uint32 请求编号 | 负载
+//               请求编号由客户端选择，服务端原样写进对应的响应帧。同一连接上可以有多个
+//               未完成的请求，响应按完成顺序返回，客户端按请求编号配对
+//   请求负载 := 方法 | 参数
+//               方法为 UINT32 函数编号或 STRING 函数名（定长编码），
+//               参数与 RpcProvider::call_function_binary 相同（可以以 COMPACT_MARKER 开头）
+//   响应负载 := uint8 状态 | 内容
+//               状态为 OK 时内容为返回值（void 返回为空），否则为 STRING 错误信息
+//
+// Unix 域套接字上的请求帧可以在长度字段中置 frame_descriptor_flag：此时帧只有帧头，
+// 负载放在随帧头一起通过 SCM_RIGHTS 传来的 memfd 中，长度为其余 31 位
+namespace rpc {
+namespace net {
+    inline constexpr size_t frame_header_size = 2 * sizeof(uint32_t);
+
+    inline constexpr uint32_t frame_descriptor_flag = 0x80000000u;
+
+    // 响应状态：RpcException::ErrorType + 1，处理函数抛出的其他异常为 HANDLER_ERROR
+    enum class FrameStatus : uint8_t {
+        OK = 0,
+        FUNCTION_NOT_FOUND = 1,
+        TYPE_MISMATCH = 2,
+        ARGUMENT_ERROR = 3,
+        TIMEOUT_ERROR = 4,
+        OVERLOAD_ERROR = 5,
+        HANDLER_ERROR = 0xFF
+    };
+
+    // 在 out 末尾写入帧头（长度字段稍后回填），返回帧的起始位置
+    inline size_t begin_frame(std::vector<uint8_t>& out, uint32_t request_id = 0) {
+        size_t start = out.size();
+        out.resize(start + frame_header_size);
+        serialization::byte_order::store(out.data() + start + sizeof(uint32_t), request_id);
+        return start;
+    }
+
+    // 负载写完后回填长度字段
+    inline void end_frame(std::vector<uint8_t>& out, size_t start) {
+        uint32_t length = static_cast<uint32_t>(out.size() - start - frame_header_size);
+        serialization::byte_order::store(out.data() + start, length);
+    }
+
+    // 读取一个完整帧的负载。数据不足一帧时返回 nullopt，needed 为至少还需要的字节数
+    inline std::optional<ByteSpan> next_frame(ByteSpan input, size_t& needed) {
+        if (input.size() < frame_header_size) {
+            needed = frame_header_size - input.size();
+            return std::nullopt;
+        }
+        uint32_t length = serialization::byte_order::load<uint32_t>(input.data());
+        if (input.size() - frame_header_size < length) {
+            needed = frame_header_size + length - input.size();
+            return std::nullopt;
+        }
+        needed = 0;
+        return input.subspan(frame_header_size, length);
+    }
+
+    inline uint32_t frame_payload_length(const uint8_t* header) {
+        return serialization::byte_order::load<uint32_t>(header);
+    }
+
+    inline uint32_t frame_request_id(const uint8_t* header) {
+        return serialization::byte_order::load<uint32_t>(header + sizeof(uint32_t));
+    }
+
+    inline void encode_request(std::vector<uint8_t>& out, uint32_t function_id, ByteSpan args,
+                               uint32_t request_id = 0) {
+        size_t start = begin_frame(out, request_id);
+        serialization::serialize_value(out, function_id);
+        out.insert(out.end(), args.begin(), args.end());
+        end_frame(out, start);
+    }
+
+    inline void encode_request(std::vector<uint8_t>& out, const std::string& method, ByteSpan args,
+                               uint32_t request_id = 0) {
+        size_t start = begin_frame(out, request_id);
+        serialization::serialize_value(out, method);
+        out.insert(out.end(), args.begin(), args.end());
+        end_frame(out, start);
+    }
+
+    // 错误响应的负载（不含帧头）
+    inline void encode_error(std::vector<uint8_t>& out, FrameStatus status, const std::string& message) {
+        out.push_back(static_cast<uint8_t>(status));
+        serialization::serialize_value(out, message);
+    }
+}
+}
+
+#endif
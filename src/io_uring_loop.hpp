@@ -0,0 +1,621 @@
+#ifndef __RPC_IO_URING_LOOP_H__
+#define __RPC_IO_URING_LOOP_H__
+
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "completion_queue.hpp"
+#include "event_loop.hpp"
+#include "rpc_provider.hpp"
+#include "server_session.hpp"
+
+namespace rpc {
+namespace net {
+    // 直接使用 io_uring 系统调用，不依赖 liburing
+    namespace uring {
+        inline int setup(unsigned entries, io_uring_params* params) {
+            return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+        }
+
+        inline int enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+            return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+        }
+
+        inline int register_ring(int fd, unsigned opcode, void* arg, unsigned count) {
+            return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+        }
+
+        // 与内核共享的环形队列下标：读对方写入的下标用 acquire，发布自己的下标用 release
+        template<typename T>
+        T load_acquire(const T* p) { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+
+        template<typename T>
+        void store_release(T* p, T value) { __atomic_store_n(p, value, __ATOMIC_RELEASE); }
+
+        // 提交队列、完成队列和 SQE 数组的内存映射
+        class Ring {
+        public:
+            explicit Ring(unsigned entries) {
+                io_uring_params params{};
+                params.flags = IORING_SETUP_CLAMP;
+                fd_ = setup(entries, &params);
+                if (fd_ < 0) {
+                    throw_errno("io_uring_setup");
+                }
+
+                sq_map_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                cq_map_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+                if (single_mmap) {
+                    sq_map_size_ = cq_map_size_ = std::max(sq_map_size_, cq_map_size_);
+                }
+                sq_map_ = map(sq_map_size_, IORING_OFF_SQ_RING);
+                cq_map_ = single_mmap ? sq_map_ : map(cq_map_size_, IORING_OFF_CQ_RING);
+                sqes_map_size_ = params.sq_entries * sizeof(io_uring_sqe);
+                sqes_ = static_cast<io_uring_sqe*>(map(sqes_map_size_, IORING_OFF_SQES));
+                if (sq_map_ == MAP_FAILED || cq_map_ == MAP_FAILED || sqes_ == MAP_FAILED) {
+                    int error = errno;
+                    release();
+                    throw std::system_error(error, std::generic_category(), "mmap(io_uring)");
+                }
+
+                char* sq = static_cast<char*>(sq_map_);
+                sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+                sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+                sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+                sq_entries_ = params.sq_entries;
+                // SQE 下标数组固定为恒等映射，之后只需移动 tail
+                unsigned* array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+                for (unsigned i = 0; i < sq_entries_; ++i) {
+                    array[i] = i;
+                }
+                sq_local_tail_ = *sq_tail_;
+
+                char* cq = static_cast<char*>(cq_map_);
+                cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+                cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+                cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+                cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+            }
+
+            Ring(const Ring&) = delete;
+            Ring& operator=(const Ring&) = delete;
+
+            ~Ring() { release(); }
+
+            int fd() const { return fd_; }
+
+            // 取得一个清零的 SQE；队列已满时先提交已准备的 SQE。完成队列溢出时内核拒绝接收新的 SQE（-EBUSY），
+            // 把已完成的事件移到 backlog_ 腾出空间后重试，它们稍后由 drain() 处理，这里不调用处理函数以免重入
+            io_uring_sqe* get_sqe() {
+                unsigned wait = 0;
+                while (sq_local_tail_ - load_acquire(sq_head_) >= sq_entries_) {
+                    stash_completions();
+                    int result = submit(wait);
+                    if (result < 0 && result != -EINTR && result != -EAGAIN && result != -EBUSY) {
+                        throw std::system_error(-result, std::generic_category(), "io_uring_enter");
+                    }
+                    wait = 1;
+                }
+                io_uring_sqe* sqe = &sqes_[sq_local_tail_ & sq_mask_];
+                ++sq_local_tail_;
+                std::memset(sqe, 0, sizeof(*sqe));
+                return sqe;
+            }
+
+            // 一次系统调用提交所有已准备的 SQE，并等待至少 wait 个完成事件；失败时返回 -errno
+            int submit(unsigned wait) {
+                unsigned to_submit = sq_local_tail_ - *sq_tail_;
+                store_release(sq_tail_, sq_local_tail_);
+                int result = enter(fd_, to_submit, wait, wait ? IORING_ENTER_GETEVENTS : 0);
+                return result < 0 ? -errno : result;
+            }
+
+            // 按完成顺序逐个处理事件，get_sqe() 暂存的在前；先复制再归还槽位，回调中可以继续准备 SQE
+            template<typename Handler>
+            void drain(Handler&& handler) {
+                while (true) {
+                    if (!backlog_.empty()) {
+                        std::vector<io_uring_cqe> pending;
+                        pending.swap(backlog_);
+                        for (const io_uring_cqe& cqe : pending) {
+                            handler(cqe);
+                        }
+                        continue;
+                    }
+                    unsigned head = *cq_head_;
+                    if (head == load_acquire(cq_tail_)) {
+                        return;
+                    }
+                    io_uring_cqe cqe = cqes_[head & cq_mask_];
+                    store_release(cq_head_, head + 1);
+                    handler(cqe);
+                }
+            }
+
+            // 内核是否支持 ops 中的所有操作码
+            bool supports(std::initializer_list<unsigned> ops) const {
+                constexpr unsigned count = 256;
+                std::vector<uint8_t> storage(sizeof(io_uring_probe) + count * sizeof(io_uring_probe_op));
+                auto* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+                if (register_ring(fd_, IORING_REGISTER_PROBE, probe, count) < 0) {
+                    return false;
+                }
+                for (unsigned op : ops) {
+                    if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+        private:
+            int fd_ = -1;
+            void* sq_map_ = MAP_FAILED;
+            void* cq_map_ = MAP_FAILED;
+            io_uring_sqe* sqes_ = static_cast<io_uring_sqe*>(MAP_FAILED);
+            size_t sq_map_size_ = 0;
+            size_t cq_map_size_ = 0;
+            size_t sqes_map_size_ = 0;
+            unsigned* sq_head_ = nullptr;
+            unsigned* sq_tail_ = nullptr;
+            unsigned sq_mask_ = 0;
+            unsigned sq_entries_ = 0;
+            unsigned sq_local_tail_ = 0;
+            unsigned* cq_head_ = nullptr;
+            unsigned* cq_tail_ = nullptr;
+            unsigned cq_mask_ = 0;
+            io_uring_cqe* cqes_ = nullptr;
+            std::vector<io_uring_cqe> backlog_;
+
+            void stash_completions() {
+                unsigned head = *cq_head_;
+                unsigned tail = load_acquire(cq_tail_);
+                for (; head != tail; ++head) {
+                    backlog_.push_back(cqes_[head & cq_mask_]);
+                }
+                store_release(cq_head_, head);
+            }
+
+            void* map(size_t size, off_t offset) {
+                return mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, offset);
+            }
+
+            void release() {
+                if (sqes_ != MAP_FAILED) munmap(sqes_, sqes_map_size_);
+                if (cq_map_ != MAP_FAILED && cq_map_ != sq_map_) munmap(cq_map_, cq_map_size_);
+                if (sq_map_ != MAP_FAILED) munmap(sq_map_, sq_map_size_);
+                if (fd_ >= 0) close(fd_);
+                sqes_ = static_cast<io_uring_sqe*>(MAP_FAILED);
+                sq_map_ = cq_map_ = MAP_FAILED;
+                fd_ = -1;
+            }
+        };
+
+        // 提供给内核的接收缓冲区环（IORING_REGISTER_PBUF_RING）：多路 recv 到达数据时由内核挑选缓冲区，
+        // 空闲连接不占用任何接收缓冲区
+        class BufferRing {
+        public:
+            BufferRing(const Ring& ring, uint16_t group, unsigned count, unsigned buffer_size)
+                : ring_fd_(ring.fd()), group_(group), count_(count), buffer_size_(buffer_size),
+                  data_(static_cast<size_t>(count) * buffer_size) {
+                if (count == 0 || (count & (count - 1)) != 0 || count > 32768) {
+                    throw std::system_error(EINVAL, std::generic_category(), "uring_buffer_count must be a power of two");
+                }
+                ring_bytes_ = count * sizeof(io_uring_buf);
+                entries_ = static_cast<io_uring_buf*>(mmap(nullptr, ring_bytes_, PROT_READ | PROT_WRITE,
+                                                           MAP_ANONYMOUS | MAP_PRIVATE, -1, 0));
+                if (entries_ == MAP_FAILED) {
+                    throw_errno("mmap(buffer ring)");
+                }
+                io_uring_buf_reg reg{};
+                reg.ring_addr = reinterpret_cast<uint64_t>(entries_);
+                reg.ring_entries = count;
+                reg.bgid = group;
+                if (register_ring(ring_fd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+                    int error = errno;
+                    munmap(entries_, ring_bytes_);
+                    throw std::system_error(error, std::generic_category(), "io_uring_register(PBUF_RING)");
+                }
+                // 环的 tail 与第一个条目的 resv 字段重叠
+                tail_ = &entries_[0].resv;
+                for (unsigned i = 0; i < count; ++i) {
+                    push(static_cast<uint16_t>(i));
+                }
+                store_release(tail_, local_tail_);
+            }
+
+            BufferRing(const BufferRing&) = delete;
+            BufferRing& operator=(const BufferRing&) = delete;
+
+            ~BufferRing() {
+                io_uring_buf_reg reg{};
+                reg.bgid = group_;
+                register_ring(ring_fd_, IORING_UNREGISTER_PBUF_RING, &reg, 1);
+                munmap(entries_, ring_bytes_);
+            }
+
+            uint16_t group() const { return group_; }
+
+            const uint8_t* buffer(uint16_t id) const { return data_.data() + static_cast<size_t>(id) * buffer_size_; }
+
+            // 数据已复制出去，把缓冲区还给内核
+            void recycle(uint16_t id) {
+                push(id);
+                store_release(tail_, local_tail_);
+            }
+
+        private:
+            int ring_fd_;
+            uint16_t group_;
+            unsigned count_;
+            unsigned buffer_size_;
+            std::vector<uint8_t> data_;
+            io_uring_buf* entries_ = nullptr;
+            size_t ring_bytes_ = 0;
+            uint16_t* tail_ = nullptr;
+            uint16_t local_tail_ = 0;
+
+            void push(uint16_t id) {
+                io_uring_buf& entry = entries_[local_tail_ & (count_ - 1)];
+                entry.addr = reinterpret_cast<uint64_t>(buffer(id));
+                entry.len = buffer_size_;
+                entry.bid = id;
+                ++local_tail_;
+            }
+        };
+    }
+
+    // io_uring 事件循环：多路 accept 和使用缓冲区环的多路 recv 各只提交一次，
+    // 一轮完成事件中产生的 send 和重新提交的请求在下一次 io_uring_enter 中批量提交。
+    // 与 EpollLoop 使用相同的 ServerSession，协议行为完全一致；线程池中完成的调用同样经
+    // CompletionQueue 交回，eventfd 上常驻的 READ 完成时取走。
+    // 需要 Linux 6.0 及以上（多路 recv），内核不支持时构造函数抛出 std::system_error
+    class UringLoop : public EventLoop {
+    public:
+        UringLoop(RpcProvider& provider, const ServerOptions& options, int listen_fd)
+            : provider_(provider), max_frame_bytes_(options.max_frame_bytes), max_in_flight_(options.max_in_flight),
+              max_pending_output_(options.max_pending_output), ring_(options.uring_entries) {
+            // 多路 recv 与 IORING_OP_SEND_ZC 同时出现在 6.0，用后者的存在判断内核版本
+            if (!ring_.supports({IORING_OP_ACCEPT, IORING_OP_RECV, IORING_OP_SEND, IORING_OP_READ, IORING_OP_ASYNC_CANCEL,
+                                 IORING_OP_SEND_ZC})) {
+                throw std::system_error(ENOSYS, std::generic_category(), "io_uring lacks multishot recv support");
+            }
+            buffers_ = std::make_unique<uring::BufferRing>(ring_, 0, options.uring_buffer_count,
+                                                           options.uring_buffer_size);
+            wakeup_fd_ = eventfd(0, EFD_CLOEXEC);
+            if (wakeup_fd_ < 0) {
+                throw_errno("eventfd");
+            }
+            completions_ = std::make_shared<CompletionQueue>(wakeup_fd_);
+            // 构造成功后才接管监听套接字，失败时调用方可以改用 epoll
+            listen_fd_ = listen_fd;
+        }
+
+        UringLoop(const UringLoop&) = delete;
+        UringLoop& operator=(const UringLoop&) = delete;
+
+        ~UringLoop() override {
+            if (completions_) {
+                completions_->close();
+            }
+            for (auto& entry : connections_) {
+                shutdown(entry.second->fd, SHUT_RDWR);
+            }
+            // 内核中的请求仍引用发送缓冲区、接收缓冲区和 wakeup_value_，全部完成后成员才能析构
+            quiesce();
+            for (auto& entry : connections_) {
+                close(entry.second->fd);
+            }
+            if (listen_fd_ >= 0) close(listen_fd_);
+            if (wakeup_fd_ >= 0) close(wakeup_fd_);
+        }
+
+        void run() override {
+            arm_accept();
+            arm_wakeup();
+            while (!stopping_.load(std::memory_order_acquire)) {
+                int result = ring_.submit(1);
+                if (result < 0 && result != -EINTR && result != -EAGAIN && result != -EBUSY) {
+                    break;
+                }
+                ring_.drain([this](const io_uring_cqe& cqe) { on_completion(cqe); });
+            }
+        }
+
+        void stop() override {
+            stopping_.store(true, std::memory_order_release);
+            uint64_t one = 1;
+            ssize_t written = write(wakeup_fd_, &one, sizeof(one));
+            (void)written;
+        }
+
+    private:
+        // user_data 低 3 位为操作类型，其余为连接编号（连接编号不复用，关闭后迟到的完成事件会被忽略）
+        enum Op : uint64_t { OP_ACCEPT = 1, OP_WAKEUP = 2, OP_RECV = 3, OP_SEND = 4, OP_CANCEL = 5 };
+
+        struct Connection {
+            uint64_t id;
+            int fd;
+            ServerSession session;
+            // 正在发送的数据；发送期间 session 可以继续追加新的响应
+            std::vector<uint8_t> sending{};
+            size_t send_offset = 0;
+            bool recv_armed = false;
+            bool recv_cancelling = false;
+            bool send_in_flight = false;
+            // 对端已关闭写方向：不再读取，未完成的调用应答并发出后再关闭
+            bool peer_closed = false;
+            bool closing = false;
+        };
+
+        RpcProvider& provider_;
+        size_t max_frame_bytes_;
+        size_t max_in_flight_;
+        size_t max_pending_output_;
+        uring::Ring ring_;
+        std::unique_ptr<uring::BufferRing> buffers_;
+        int listen_fd_ = -1;
+        int wakeup_fd_ = -1;
+        uint64_t wakeup_value_ = 0;
+        std::atomic<bool> stopping_{false};
+        uint64_t next_id_ = 1;
+        // 已准备、尚未产生最后一个完成事件的请求数
+        size_t pending_ops_ = 0;
+        std::unordered_map<uint64_t, std::unique_ptr<Connection>> connections_;
+        std::shared_ptr<CompletionQueue> completions_;
+
+        static uint64_t tag(uint64_t id, Op op) { return (id << 3) | op; }
+
+        // 每个 SQE 最终恰好产生一个不带 IORING_CQE_F_MORE 的完成事件，据此统计未完成的请求
+        io_uring_sqe* prepare() {
+            io_uring_sqe* sqe = ring_.get_sqe();
+            ++pending_ops_;
+            return sqe;
+        }
+
+        // 取消所有请求并等待它们完成
+        void quiesce() {
+            if (pending_ops_ == 0) {
+                return;
+            }
+            io_uring_sqe* sqe = prepare();
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->cancel_flags = IORING_ASYNC_CANCEL_ANY;
+            sqe->user_data = tag(0, OP_CANCEL);
+            while (pending_ops_ > 0) {
+                int result = ring_.submit(1);
+                if (result < 0 && result != -EINTR && result != -EAGAIN && result != -EBUSY) {
+                    return;
+                }
+                ring_.drain([this](const io_uring_cqe& cqe) {
+                    if (!(cqe.flags & IORING_CQE_F_MORE)) {
+                        --pending_ops_;
+                    }
+                });
+            }
+        }
+
+        void arm_accept() {
+            io_uring_sqe* sqe = prepare();
+            sqe->opcode = IORING_OP_ACCEPT;
+            sqe->fd = listen_fd_;
+            sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+            sqe->accept_flags = SOCK_CLOEXEC;
+            sqe->user_data = tag(0, OP_ACCEPT);
+        }
+
+        void arm_wakeup() {
+            io_uring_sqe* sqe = prepare();
+            sqe->opcode = IORING_OP_READ;
+            sqe->fd = wakeup_fd_;
+            sqe->addr = reinterpret_cast<uint64_t>(&wakeup_value_);
+            sqe->len = sizeof(wakeup_value_);
+            sqe->user_data = tag(0, OP_WAKEUP);
+        }
+
+        void arm_recv(Connection& connection) {
+            io_uring_sqe* sqe = prepare();
+            sqe->opcode = IORING_OP_RECV;
+            sqe->fd = connection.fd;
+            sqe->ioprio = IORING_RECV_MULTISHOT;
+            sqe->flags = IOSQE_BUFFER_SELECT;
+            sqe->buf_group = buffers_->group();
+            sqe->user_data = tag(connection.id, OP_RECV);
+            connection.recv_armed = true;
+        }
+
+        // 未完成的调用达到上限或积压的响应过多时取消多路 recv，后续数据留在套接字中；
+        // 取消之前已经收到的数据仍会到达并追加到输入缓冲区
+        void pause_recv(Connection& connection) {
+            if (!connection.recv_armed || connection.recv_cancelling) {
+                return;
+            }
+            io_uring_sqe* sqe = prepare();
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->addr = tag(connection.id, OP_RECV);
+            sqe->user_data = tag(connection.id, OP_CANCEL);
+            connection.recv_cancelling = true;
+        }
+
+        // 同一时间每个连接只有一个 send，发送中的缓冲区不会被修改
+        void start_send(Connection& connection) {
+            if (connection.send_in_flight || connection.closing) {
+                return;
+            }
+            if (connection.send_offset == connection.sending.size()) {
+                if (!connection.session.has_output()) {
+                    return;
+                }
+                connection.session.take_output(connection.sending);
+                connection.send_offset = 0;
+            }
+            io_uring_sqe* sqe = prepare();
+            sqe->opcode = IORING_OP_SEND;
+            sqe->fd = connection.fd;
+            sqe->addr = reinterpret_cast<uint64_t>(connection.sending.data() + connection.send_offset);
+            sqe->len = static_cast<uint32_t>(connection.sending.size() - connection.send_offset);
+            sqe->msg_flags = MSG_NOSIGNAL;
+            sqe->user_data = tag(connection.id, OP_SEND);
+            connection.send_in_flight = true;
+        }
+
+        void on_completion(const io_uring_cqe& cqe) {
+            if (!(cqe.flags & IORING_CQE_F_MORE)) {
+                --pending_ops_;
+            }
+            uint64_t id = cqe.user_data >> 3;
+            switch (static_cast<Op>(cqe.user_data & 7)) {
+                case OP_ACCEPT:
+                    on_accept(cqe);
+                    break;
+                case OP_WAKEUP:
+                    deliver_completions();
+                    if (!stopping_.load(std::memory_order_relaxed)) {
+                        arm_wakeup();
+                    }
+                    break;
+                case OP_RECV: {
+                    auto it = connections_.find(id);
+                    if (it != connections_.end()) {
+                        on_recv(*it->second, cqe);
+                    } else if (cqe.flags & IORING_CQE_F_BUFFER) {
+                        buffers_->recycle(static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT));
+                    }
+                    break;
+                }
+                case OP_SEND: {
+                    auto it = connections_.find(id);
+                    if (it != connections_.end()) {
+                        on_send(*it->second, cqe);
+                    }
+                    break;
+                }
+                case OP_CANCEL:
+                    // 结果以被取消的 recv 的最后一个完成事件为准
+                    break;
+            }
+        }
+
+        void on_accept(const io_uring_cqe& cqe) {
+            if (cqe.res >= 0) {
+                set_nodelay(cqe.res);
+                uint64_t id = next_id_++;
+                auto connection = std::make_unique<Connection>(
+                    Connection{id, cqe.res, ServerSession(provider_, max_frame_bytes_)});
+                connection->session.enable_async(completions_, id, max_in_flight_);
+                connection->session.limit_output(max_pending_output_);
+                arm_recv(*connection);
+                connections_.emplace(id, std::move(connection));
+            }
+            if (!(cqe.flags & IORING_CQE_F_MORE) && !stopping_.load(std::memory_order_relaxed)) {
+                arm_accept();
+            }
+        }
+
+        void on_recv(Connection& connection, const io_uring_cqe& cqe) {
+            bool more = cqe.flags & IORING_CQE_F_MORE;
+            if (!more) {
+                connection.recv_armed = false;
+                connection.recv_cancelling = false;
+            }
+            if (cqe.res > 0) {
+                uint16_t buffer_id = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+                if (!connection.closing) {
+                    connection.session.append_input(ByteSpan(buffers_->buffer(buffer_id), static_cast<size_t>(cqe.res)));
+                }
+                buffers_->recycle(buffer_id);
+            } else if (cqe.res == 0) {
+                connection.peer_closed = true;
+            } else if (cqe.res != -ENOBUFS && cqe.res != -ECANCELED && !more) {
+                close_connection(connection);
+                return;
+            }
+            if (connection.closing) {
+                release_if_idle(connection);
+                return;
+            }
+            advance(connection);
+        }
+
+        void on_send(Connection& connection, const io_uring_cqe& cqe) {
+            connection.send_in_flight = false;
+            if (cqe.res < 0) {
+                close_connection(connection);
+                return;
+            }
+            connection.send_offset += static_cast<size_t>(cqe.res);
+            if (connection.closing) {
+                release_if_idle(connection);
+                return;
+            }
+            advance(connection);
+        }
+
+        // 把完成的响应追加到各自的连接，继续处理暂停的请求和读取，发送在本轮结束时批量提交
+        void deliver_completions() {
+            completions_->drain([this](uint64_t id, const std::vector<uint8_t>& frame) {
+                auto it = connections_.find(id);
+                if (it == connections_.end() || it->second->closing) {
+                    return;
+                }
+                it->second->session.complete(frame);
+                advance(*it->second);
+            });
+        }
+
+        // 发送积压的响应，处理缓冲的请求帧，再按是否暂停取消或恢复 recv；对端半关闭后应答完毕即关闭。
+        // 先取走上一轮的响应：输出积压导致的暂停随之解除，缓冲的请求可以继续处理
+        void advance(Connection& connection) {
+            start_send(connection);
+            if (!connection.session.process()) {
+                close_connection(connection);
+                return;
+            }
+            start_send(connection);
+            if (connection.peer_closed) {
+                // 没有进行中的 send 说明响应都已发出
+                if (connection.session.in_flight() == 0 && !connection.send_in_flight) {
+                    close_connection(connection);
+                }
+            } else if (connection.session.paused()) {
+                pause_recv(connection);
+            } else if (!connection.recv_armed) {
+                // 暂停期间 recv 已被取消，或多路 recv 已终止（例如缓冲区暂时用完，数据仍在套接字中），重新提交即可
+                arm_recv(connection);
+            }
+        }
+
+        // 关闭读写两端让进行中的 recv / send 尽快完成，都完成后才释放连接（内核可能仍在引用其缓冲区）
+        void close_connection(Connection& connection) {
+            if (!connection.closing) {
+                connection.closing = true;
+                shutdown(connection.fd, SHUT_RDWR);
+            }
+            release_if_idle(connection);
+        }
+
+        void release_if_idle(Connection& connection) {
+            if (!connection.recv_armed && !connection.send_in_flight) {
+                close(connection.fd);
+                connections_.erase(connection.id);
+            }
+        }
+    };
+}
+}
+
+#endif
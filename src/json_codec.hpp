@@ -0,0 +1,97 @@
+#ifndef __RPC_JSON_CODEC_H__
+#define __RPC_JSON_CODEC_H__
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include "json.hpp"
+
+// nlohmann::json 默认不支持 std::optional 和 std::variant，这里补充转换规则
+namespace nlohmann {
+    // null <-> std::nullopt
+    template<typename T>
+    struct adl_serializer<std::optional<T>> {
+        static void to_json(json& j, const std::optional<T>& value) {
+            if (value) {
+                j = *value;
+            } else {
+                j = nullptr;
+            }
+        }
+
+        static void from_json(const json& j, std::optional<T>& value) {
+            if (j.is_null()) {
+                value = std::nullopt;
+            } else {
+                value = j.get<T>();
+            }
+        }
+    };
+
+    // 先按 JSON 值的类型选择备选类型（整数 -> 整型，浮点数 -> 浮点型，字符串 -> std::string 等），
+    // 同类的备选类型按声明顺序尝试；都不能转换时再按声明顺序尝试所有备选类型，第一个能成功转换的生效
+    template<typename... Ts>
+    struct adl_serializer<std::variant<Ts...>> {
+        static void to_json(json& j, const std::variant<Ts...>& value) {
+            std::visit([&j](const auto& v) { j = v; }, value);
+        }
+
+        static void from_json(const json& j, std::variant<Ts...>& value) {
+            if (!((same_kind<Ts>(j) && try_alternative<Ts>(j, value)) || ...) &&
+                !(try_alternative<Ts>(j, value) || ...)) {
+                throw detail::type_error::create(302, "no variant alternative matches " +
+                                                 std::string(j.type_name()), &j);
+            }
+        }
+
+    private:
+        // T 是否是 j 的 JSON 类型对应的 C++ 类型
+        template<typename T>
+        static bool same_kind(const json& j) {
+            if constexpr (std::is_same_v<T, bool>) {
+                return j.is_boolean();
+            } else if constexpr (std::is_integral_v<T>) {
+                return j.is_number_integer();
+            } else if constexpr (std::is_floating_point_v<T>) {
+                return j.is_number_float();
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                return j.is_string();
+            } else if constexpr (std::is_same_v<T, std::nullptr_t>) {
+                return j.is_null();
+            } else {
+                return j.is_structured();
+            }
+        }
+
+        template<typename T>
+        static bool try_alternative(const json& j, std::variant<Ts...>& value) {
+            try {
+                value = j.get<T>();
+                return true;
+            } catch (const json::exception&) {
+                return false;
+            }
+        }
+    };
+}
+
+namespace rpc {
+namespace detail {
+    // 判断类型能否从 JSON 解码
+    template<typename T, typename = void>
+    struct is_json_decodable : std::false_type {};
+
+    template<typename T>
+    struct is_json_decodable<T, std::void_t<decltype(
+        std::declval<const nlohmann::json&>().get_to(std::declval<T&>())
+    )>> : std::true_type {};
+
+    template<typename T>
+    inline constexpr bool is_json_decodable_v = is_json_decodable<T>::value;
+}
+}
+
+#endif
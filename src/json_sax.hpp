@@ -0,0 +1,350 @@
+#ifndef __RPC_JSON_SAX_H__
+#define __RPC_JSON_SAX_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "json.hpp"
+#include "param_index.hpp"
+
+namespace rpc {
+namespace detail {
+    // SAX 事件中的标量值
+    struct SaxScalar {
+        enum class Kind { BOOLEAN, INTEGER, UNSIGNED, FLOAT, STRING };
+
+        Kind kind;
+        bool boolean = false;
+        int64_t integer = 0;
+        uint64_t unsigned_integer = 0;
+        double floating = 0.0;
+        std::string* string = nullptr;  // 字符串可直接移动进槽位
+
+        // 转换为 DOM 值（用于回退路径）
+        nlohmann::json to_json() const {
+            switch (kind) {
+                case Kind::BOOLEAN: return boolean;
+                case Kind::INTEGER: return integer;
+                case Kind::UNSIGNED: return unsigned_integer;
+                case Kind::FLOAT: return floating;
+                case Kind::STRING: return *string;
+            }
+            return nullptr;
+        }
+    };
+
+    // 参数槽位如何接收 SAX 事件
+    enum class SaxKind {
+        SCALAR,        // 数字、布尔、字符串：直接赋值
+        SCALAR_ARRAY,  // 元素为标量的 std::vector：逐个 push_back
+        DOM            // 其他类型：先构建该参数的子 DOM 再转换
+    };
+
+    struct SaxSink {
+        SaxKind kind;
+        const char* expected;  // 期望的 JSON 类型，用于错误信息
+        bool (*assign)(void* slot, SaxScalar& value);
+        void (*clear)(void* slot);
+        bool (*push)(void* slot, SaxScalar& value);
+    };
+
+    template<typename T>
+    inline constexpr bool is_sax_scalar_v =
+        std::is_arithmetic_v<T> || std::is_same_v<T, std::string>;
+
+    // 标量赋值，语义与 nlohmann::json::get<T>() 一致：数字之间可以互相转换，布尔值可转为数字
+    template<typename T>
+    bool assign_scalar(T& out, SaxScalar& value) {
+        using Kind = SaxScalar::Kind;
+        if constexpr (std::is_same_v<T, bool>) {
+            if (value.kind != Kind::BOOLEAN) return false;
+            out = value.boolean;
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            switch (value.kind) {
+                case Kind::BOOLEAN: out = static_cast<T>(value.boolean); break;
+                case Kind::INTEGER: out = static_cast<T>(value.integer); break;
+                case Kind::UNSIGNED: out = static_cast<T>(value.unsigned_integer); break;
+                case Kind::FLOAT: out = static_cast<T>(value.floating); break;
+                default: return false;
+            }
+        } else {
+            if (value.kind != Kind::STRING) return false;
+            out = std::move(*value.string);
+        }
+        return true;
+    }
+
+    template<typename T>
+    constexpr const char* scalar_name() {
+        if constexpr (std::is_same_v<T, bool>) return "boolean";
+        else if constexpr (std::is_arithmetic_v<T>) return "number";
+        else return "string";
+    }
+
+    template<typename T>
+    struct is_scalar_vector : std::false_type {};
+
+    template<typename E>
+    struct is_scalar_vector<std::vector<E>> : std::bool_constant<is_sax_scalar_v<E>> {};
+
+    // 为参数类型生成 SAX 接收器
+    template<typename T>
+    SaxSink make_sax_sink() {
+        if constexpr (is_sax_scalar_v<T>) {
+            return SaxSink{
+                SaxKind::SCALAR, scalar_name<T>(),
+                [](void* slot, SaxScalar& value) { return assign_scalar(*static_cast<T*>(slot), value); },
+                nullptr, nullptr
+            };
+        } else if constexpr (is_scalar_vector<T>::value) {
+            using E = typename T::value_type;
+            return SaxSink{
+                SaxKind::SCALAR_ARRAY, "array",
+                nullptr,
+                [](void* slot) { static_cast<T*>(slot)->clear(); },
+                [](void* slot, SaxScalar& value) {
+                    E element{};
+                    if (!assign_scalar(element, value)) return false;
+                    static_cast<T*>(slot)->push_back(std::move(element));
+                    return true;
+                }
+            };
+        } else {
+            return SaxSink{SaxKind::DOM, "value", nullptr, nullptr, nullptr};
+        }
+    }
+
+    template<typename Tuple, size_t... I>
+    std::vector<SaxSink> make_sax_sinks(std::index_sequence<I...>) {
+        return {make_sax_sink<std::tuple_element_t<I, Tuple>>()...};
+    }
+
+    // 流式解析命名参数对象，按参数下标把值直接写入参数槽位。
+    // 只有 SaxKind::DOM 类型的参数才会为其构建子 DOM。
+    //
+    // Context 需要提供：
+    //   const SaxSink& sink(size_t index)            参数的接收器
+    //   void* slot(size_t index)                     参数槽位
+    //   int lookup(const std::string& key)           参数下标，未知参数返回 -1
+    //   void decode_dom(size_t index, const json&)   把子 DOM 转换进参数槽位
+    //   void type_error(size_t index)                抛出类型不匹配异常
+    //   void not_an_object()                         抛出参数不是对象的异常
+    template<typename Context>
+    class SaxArgumentHandler {
+    public:
+        using number_integer_t = nlohmann::json::number_integer_t;
+        using number_unsigned_t = nlohmann::json::number_unsigned_t;
+        using number_float_t = nlohmann::json::number_float_t;
+        using string_t = nlohmann::json::string_t;
+        using binary_t = nlohmann::json::binary_t;
+
+        explicit SaxArgumentHandler(Context& context) : ctx_(context) {}
+
+        bool null() {
+            nlohmann::json value(nullptr);
+            return on_dom_only_value(std::move(value));
+        }
+
+        bool boolean(bool v) {
+            SaxScalar value{SaxScalar::Kind::BOOLEAN};
+            value.boolean = v;
+            return on_scalar(value);
+        }
+
+        bool number_integer(number_integer_t v) {
+            SaxScalar value{SaxScalar::Kind::INTEGER};
+            value.integer = v;
+            return on_scalar(value);
+        }
+
+        bool number_unsigned(number_unsigned_t v) {
+            SaxScalar value{SaxScalar::Kind::UNSIGNED};
+            value.unsigned_integer = v;
+            return on_scalar(value);
+        }
+
+        bool number_float(number_float_t v, const string_t&) {
+            SaxScalar value{SaxScalar::Kind::FLOAT};
+            value.floating = v;
+            return on_scalar(value);
+        }
+
+        bool string(string_t& v) {
+            SaxScalar value{SaxScalar::Kind::STRING};
+            value.string = &v;
+            return on_scalar(value);
+        }
+
+        bool binary(binary_t& v) {
+            return on_dom_only_value(nlohmann::json::binary(std::move(v)));
+        }
+
+        bool start_object(std::size_t) {
+            return open(true);
+        }
+
+        bool key(string_t& k) {
+            if (depth_ == 1) {
+                int index = ctx_.lookup(k);
+                current_ = index;
+                if (index >= 0) {
+                    seen_.insert(static_cast<size_t>(index));
+                }
+            } else if (mode_ == Mode::CAPTURE) {
+                pending_key_ = std::move(k);
+            }
+            return true;
+        }
+
+        bool end_object() {
+            return close();
+        }
+
+        bool start_array(std::size_t) {
+            return open(false);
+        }
+
+        bool end_array() {
+            return close();
+        }
+
+        bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) {
+            throw e;
+        }
+
+        // 参数是否出现过
+        bool seen(size_t index) const { return seen_.contains(index); }
+
+    private:
+        enum class Mode { NONE, SKIP, ARRAY, CAPTURE };
+
+        void type_error(size_t index) {
+            ctx_.type_error(index);
+        }
+
+        bool on_scalar(SaxScalar& value) {
+            if (depth_ == 0) {
+                ctx_.not_an_object();
+            }
+            if (depth_ == 1) {
+                if (current_ < 0) return true;
+                size_t index = static_cast<size_t>(current_);
+                const SaxSink& sink = ctx_.sink(index);
+                if (sink.kind == SaxKind::SCALAR) {
+                    if (!sink.assign(ctx_.slot(index), value)) type_error(index);
+                } else if (sink.kind == SaxKind::DOM) {
+                    ctx_.decode_dom(index, value.to_json());
+                } else {
+                    type_error(index);
+                }
+                return true;
+            }
+            if (mode_ == Mode::ARRAY) {
+                if (depth_ != 2 || !ctx_.sink(current_).push(ctx_.slot(current_), value)) {
+                    type_error(static_cast<size_t>(current_));
+                }
+            } else if (mode_ == Mode::CAPTURE) {
+                capture(value.to_json());
+            }
+            return true;
+        }
+
+        // null 和 binary 只有 DOM 类型的参数能接收
+        bool on_dom_only_value(nlohmann::json&& value) {
+            if (depth_ == 0) {
+                ctx_.not_an_object();
+            }
+            if (depth_ == 1) {
+                if (current_ < 0) return true;
+                size_t index = static_cast<size_t>(current_);
+                if (ctx_.sink(index).kind != SaxKind::DOM) {
+                    type_error(index);
+                }
+                ctx_.decode_dom(index, value);
+            } else if (mode_ == Mode::ARRAY) {
+                type_error(static_cast<size_t>(current_));
+            } else if (mode_ == Mode::CAPTURE) {
+                capture(std::move(value));
+            }
+            return true;
+        }
+
+        bool open(bool is_object) {
+            if (depth_ == 0) {
+                if (!is_object) {
+                    ctx_.not_an_object();
+                }
+                ++depth_;
+                return true;
+            }
+            if (depth_ == 1) {
+                if (current_ < 0) {
+                    mode_ = Mode::SKIP;
+                } else {
+                    size_t index = static_cast<size_t>(current_);
+                    const SaxSink& sink = ctx_.sink(index);
+                    if (sink.kind == SaxKind::SCALAR_ARRAY && !is_object) {
+                        sink.clear(ctx_.slot(index));
+                        mode_ = Mode::ARRAY;
+                    } else if (sink.kind == SaxKind::DOM) {
+                        mode_ = Mode::CAPTURE;
+                        captured_ = is_object ? nlohmann::json::object() : nlohmann::json::array();
+                        stack_.assign(1, &captured_);
+                    } else {
+                        type_error(index);
+                    }
+                }
+            } else if (mode_ == Mode::ARRAY) {
+                type_error(static_cast<size_t>(current_));
+            } else if (mode_ == Mode::CAPTURE) {
+                stack_.push_back(capture(is_object ? nlohmann::json::object() : nlohmann::json::array()));
+            }
+            ++depth_;
+            return true;
+        }
+
+        bool close() {
+            --depth_;
+            if (mode_ == Mode::CAPTURE) {
+                stack_.pop_back();
+            }
+            if (depth_ == 1) {
+                if (mode_ == Mode::CAPTURE) {
+                    ctx_.decode_dom(static_cast<size_t>(current_), captured_);
+                }
+                mode_ = Mode::NONE;
+            }
+            return true;
+        }
+
+        // 把值放进正在构建的子 DOM，返回其位置
+        nlohmann::json* capture(nlohmann::json&& value) {
+            nlohmann::json* parent = stack_.back();
+            if (parent->is_array()) {
+                parent->push_back(std::move(value));
+                return &parent->back();
+            }
+            nlohmann::json& member = (*parent)[pending_key_];
+            member = std::move(value);
+            return &member;
+        }
+
+        Context& ctx_;
+
+        int depth_ = 0;
+        int current_ = -1;
+        Mode mode_ = Mode::NONE;
+        ParamSet seen_;
+
+        nlohmann::json captured_;
+        std::vector<nlohmann::json*> stack_;
+        std::string pending_key_;
+    };
+}
+}
+
+#endif
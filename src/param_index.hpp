@@ -0,0 +1,128 @@
+#ifndef __RPC_PARAM_INDEX_H__
+#define __RPC_PARAM_INDEX_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rpc {
+namespace detail {
+    // FNV-1a 哈希，seed 用于搜索无冲突的完美哈希
+    constexpr uint32_t fnv1a(std::string_view s, uint32_t seed) {
+        uint32_t hash = 2166136261u ^ seed;
+        for (char c : s) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    constexpr size_t next_power_of_two(size_t n) {
+        size_t size = 1;
+        while (size < n) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    // 参数名 -> 参数下标的完美哈希索引，注册时构建一次。
+    // 查找只需一次哈希、一次槽位访问和一次长度 + memcmp 比较，不分配内存。
+    class ParamIndex {
+    public:
+        ParamIndex() = default;
+
+        explicit ParamIndex(const std::vector<std::string>& names) : names_(names) {
+            if (names_.empty()) {
+                return;
+            }
+            for (size_t size = next_power_of_two(names_.size() * 2); ; size *= 2) {
+                for (uint32_t seed = 0; seed < 1000; ++seed) {
+                    if (try_build(seed, size)) {
+                        return;
+                    }
+                }
+            }
+        }
+
+        // 返回参数下标，未知参数返回 -1
+        int find(std::string_view key) const {
+            if (slots_.empty()) {
+                return -1;
+            }
+            const Slot& slot = slots_[fnv1a(key, seed_) & mask_];
+            if (slot.index < 0 || slot.length != key.size()) {
+                return -1;
+            }
+            const std::string& name = names_[static_cast<size_t>(slot.index)];
+            if (std::memcmp(name.data(), key.data(), key.size()) != 0) {
+                return -1;
+            }
+            return slot.index;
+        }
+
+        size_t size() const { return names_.size(); }
+
+    private:
+        struct Slot {
+            int32_t index = -1;
+            uint32_t length = 0;
+        };
+
+        bool try_build(uint32_t seed, size_t size) {
+            std::vector<Slot> slots(size);
+            for (size_t i = 0; i < names_.size(); ++i) {
+                Slot& slot = slots[fnv1a(names_[i], seed) & (size - 1)];
+                if (slot.index >= 0) {
+                    // RpcProvider 注册时已拒绝重复的参数名；单独使用时保留第一个
+                    if (names_[static_cast<size_t>(slot.index)] == names_[i]) {
+                        continue;
+                    }
+                    return false;
+                }
+                slot.index = static_cast<int32_t>(i);
+                slot.length = static_cast<uint32_t>(names_[i].size());
+            }
+            slots_ = std::move(slots);
+            seed_ = seed;
+            mask_ = size - 1;
+            return true;
+        }
+
+        std::vector<std::string> names_;
+        std::vector<Slot> slots_;
+        uint32_t seed_ = 0;
+        size_t mask_ = 0;
+    };
+
+    // 记录已出现的参数下标：前 64 个参数用位掩码，更多参数时才分配
+    class ParamSet {
+    public:
+        void insert(size_t index) {
+            if (index < 64) {
+                mask_ |= uint64_t(1) << index;
+            } else {
+                if (overflow_.size() <= index - 64) {
+                    overflow_.resize(index - 63, false);
+                }
+                overflow_[index - 64] = true;
+            }
+        }
+
+        bool contains(size_t index) const {
+            if (index < 64) {
+                return (mask_ & (uint64_t(1) << index)) != 0;
+            }
+            return index - 64 < overflow_.size() && overflow_[index - 64];
+        }
+
+    private:
+        uint64_t mask_ = 0;
+        std::vector<bool> overflow_;
+    };
+}
+}
+
+#endif
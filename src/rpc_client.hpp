@@ -0,0 +1,290 @@
+#ifndef __RPC_RPC_CLIENT_H__
+#define __RPC_RPC_CLIENT_H__
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "event_loop.hpp"
+#include "frame.hpp"
+#include "rpc_provider.hpp"
+#include "unix_socket.hpp"
+
+namespace rpc {
+    namespace net {
+        // 解析响应负载：成功时返回返回值的编码，错误响应抛出 RpcException
+        // （处理函数抛出的其他异常为 std::runtime_error）
+        inline std::vector<uint8_t> decode_response(std::vector<uint8_t> payload) {
+            if (payload.empty()) {
+                throw std::runtime_error("Empty response frame");
+            }
+            auto status = static_cast<FrameStatus>(payload[0]);
+            if (status == FrameStatus::OK) {
+                payload.erase(payload.begin());
+                return payload;
+            }
+            ByteSpan body(payload.data() + 1, payload.size() - 1);
+            std::string message = serialization::Deserializer(body).deserialize<std::string>();
+            if (status == FrameStatus::HANDLER_ERROR) {
+                throw std::runtime_error(message);
+            }
+            throw RpcException(static_cast<RpcException::ErrorType>(static_cast<uint8_t>(status) - 1), message);
+        }
+    }
+
+    // 阻塞式客户端（TCP 或 Unix 域套接字），可以被多个线程同时使用。
+    // 一个连接上可以有多个未完成的请求：send() 发出请求并返回请求编号，wait() 等待对应的响应。
+    // 响应按服务端完成的顺序到达，先到的其他响应暂存起来。没有专门的接收线程：
+    // 等待中的线程轮流读取套接字，同一时间只有一个线程在读
+    class RpcClient {
+    public:
+        RpcClient(const std::string& host, uint16_t port) {
+            fd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (fd_ < 0) {
+                net::throw_errno("socket");
+            }
+            sockaddr_in address = net::make_address(host, port);
+            if (connect(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+                int error = errno;
+                close(fd_);
+                throw std::system_error(error, std::generic_category(), "connect");
+            }
+            net::set_nodelay(fd_);
+        }
+
+        // 连接 ServerOptions::unix_path 上的服务器。参数编码不小于 descriptor_threshold 字节的请求
+        // 放进 memfd 传递描述符，不经过套接字复制；0 表示总是走套接字
+        static RpcClient connect_unix(const std::string& path,
+                                      size_t descriptor_threshold = default_descriptor_threshold) {
+            return RpcClient(net::connect_unix(path), descriptor_threshold);
+        }
+
+        // 默认的描述符传递阈值：更小的负载 memfd_create + mmap 的开销超过复制
+        static constexpr size_t default_descriptor_threshold = 256 * 1024;
+
+        RpcClient(const RpcClient&) = delete;
+        RpcClient& operator=(const RpcClient&) = delete;
+
+        ~RpcClient() { close(fd_); }
+
+        // invoke_async() 的结果，不能比创建它的 RpcClient 活得更久。
+        // get() 等待响应并解码；不调用 get() 就析构时放弃该请求
+        template<typename Ret>
+        class PendingCall {
+        public:
+            PendingCall(PendingCall&& other) noexcept
+                : client_(std::exchange(other.client_, nullptr)), request_id_(other.request_id_) {}
+            PendingCall& operator=(PendingCall&&) = delete;
+
+            ~PendingCall() {
+                if (client_) {
+                    client_->abandon(request_id_);
+                }
+            }
+
+            Ret get() {
+                RpcClient* client = std::exchange(client_, nullptr);
+                if (!client) {
+                    throw std::logic_error("PendingCall::get() called twice");
+                }
+                auto reply = client->wait(request_id_);
+                if constexpr (!std::is_void_v<Ret>) {
+                    return serialization::Deserializer(reply).deserialize<Ret>();
+                }
+            }
+
+            uint32_t request_id() const { return request_id_; }
+
+        private:
+            friend class RpcClient;
+            PendingCall(RpcClient* client, uint32_t request_id) : client_(client), request_id_(request_id) {}
+
+            RpcClient* client_;
+            uint32_t request_id_;
+        };
+
+        // 发送请求，返回请求编号。参数的编码同 RpcProvider::call_function_binary
+        uint32_t send(FunctionId id, ByteSpan args) {
+            return send_request(id, args);
+        }
+
+        uint32_t send(const std::string& method, ByteSpan args) {
+            return send_request(method, args);
+        }
+
+        // 等待 send() 返回的请求编号对应的响应，返回值的编码同 RpcProvider::call_function_binary；
+        // 错误响应抛出 RpcException（处理函数抛出的其他异常为 std::runtime_error），连接断开抛出 std::system_error
+        std::vector<uint8_t> wait(uint32_t request_id) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (true) {
+                auto it = arrived_.find(request_id);
+                if (it != arrived_.end()) {
+                    std::vector<uint8_t> payload = std::move(it->second);
+                    arrived_.erase(it);
+                    lock.unlock();
+                    return net::decode_response(std::move(payload));
+                }
+                if (failure_) {
+                    std::rethrow_exception(failure_);
+                }
+                if (reading_) {
+                    cv_.wait(lock);
+                    continue;
+                }
+
+                reading_ = true;
+                lock.unlock();
+                uint32_t received_id = 0;
+                std::vector<uint8_t> payload;
+                std::exception_ptr error;
+                try {
+                    payload = receive_frame(received_id);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                lock.lock();
+                reading_ = false;
+                cv_.notify_all();
+                if (error) {
+                    failure_ = error;
+                } else if (received_id == request_id) {
+                    lock.unlock();
+                    return net::decode_response(std::move(payload));
+                } else if (abandoned_.erase(received_id) == 0) {
+                    arrived_[received_id] = std::move(payload);
+                }
+            }
+        }
+
+        // 不再等待该请求，响应到达后直接丢弃
+        void abandon(uint32_t request_id) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (arrived_.erase(request_id) == 0) {
+                abandoned_.insert(request_id);
+            }
+        }
+
+        std::vector<uint8_t> call(FunctionId id, ByteSpan args) {
+            return wait(send(id, args));
+        }
+
+        std::vector<uint8_t> call(const std::string& method, ByteSpan args) {
+            return wait(send(method, args));
+        }
+
+        // 按函数编号或函数名调用，参数和返回值按 serialization 格式编解码
+        template<typename Ret, typename Method, typename... Args>
+        Ret invoke(const Method& method, const Args&... args) {
+            return invoke_async<Ret>(method, args...).get();
+        }
+
+        // 只发送请求，返回值在 PendingCall::get() 时等待；多个调用可以同时在服务端执行
+        template<typename Ret, typename Method, typename... Args>
+        PendingCall<Ret> invoke_async(const Method& method, const Args&... args) {
+            static_assert(!serialization::is_borrowed_v<Ret>, "Return values must own their data");
+            std::vector<uint8_t> encoded;
+            serialization::serialize_into(encoded, args...);
+            return PendingCall<Ret>(this, send(method, encoded));
+        }
+
+    private:
+        int fd_ = -1;
+        size_t descriptor_threshold_ = 0;
+
+        // 发送端：请求编号和发送缓冲区
+        std::mutex send_mutex_;
+        uint32_t next_request_id_ = 0;
+        std::vector<uint8_t> send_buffer_;
+
+        // 接收端：已到达但还没有被取走的响应、被放弃的请求、连接错误
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool reading_ = false;
+        std::unordered_map<uint32_t, std::vector<uint8_t>> arrived_;
+        std::unordered_set<uint32_t> abandoned_;
+        std::exception_ptr failure_;
+
+        RpcClient(int fd, size_t descriptor_threshold) : fd_(fd), descriptor_threshold_(descriptor_threshold) {}
+
+        template<typename Method>
+        uint32_t send_request(const Method& method, ByteSpan args) {
+            std::lock_guard<std::mutex> lock(send_mutex_);
+            uint32_t request_id = ++next_request_id_;
+            send_buffer_.clear();
+            if (descriptor_threshold_ == 0 || args.size() < descriptor_threshold_) {
+                net::encode_request(send_buffer_, method, args, request_id);
+                send_all(send_buffer_);
+                return request_id;
+            }
+            // 方法与参数写进 memfd，套接字上只发送带 frame_descriptor_flag 的帧头
+            size_t start = net::begin_frame(send_buffer_, request_id);
+            serialization::serialize_value(send_buffer_, method);
+            ByteSpan prefix = ByteSpan(send_buffer_).subspan(net::frame_header_size);
+            size_t length = prefix.size() + args.size();
+            if (length >= net::frame_descriptor_flag) {
+                throw std::length_error("Request payload too large");
+            }
+            int payload = net::make_payload_descriptor(prefix, args);
+            send_buffer_.resize(start + net::frame_header_size);
+            serialization::byte_order::store(send_buffer_.data() + start,
+                                             static_cast<uint32_t>(length) | net::frame_descriptor_flag);
+            try {
+                net::send_with_descriptor(fd_, send_buffer_, payload);
+            } catch (...) {
+                close(payload);
+                throw;
+            }
+            close(payload);
+            return request_id;
+        }
+
+        void send_all(ByteSpan data) {
+            size_t sent = 0;
+            while (sent < data.size()) {
+                ssize_t n = ::send(fd_, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    net::throw_errno("send");
+                }
+                sent += static_cast<size_t>(n);
+            }
+        }
+
+        void receive_all(uint8_t* out, size_t size) {
+            size_t received = 0;
+            while (received < size) {
+                ssize_t n = recv(fd_, out + received, size - received, 0);
+                if (n == 0) {
+                    throw std::system_error(ECONNRESET, std::generic_category(), "Connection closed by server");
+                }
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    net::throw_errno("recv");
+                }
+                received += static_cast<size_t>(n);
+            }
+        }
+
+        std::vector<uint8_t> receive_frame(uint32_t& request_id) {
+            uint8_t header[net::frame_header_size];
+            receive_all(header, sizeof(header));
+            request_id = net::frame_request_id(header);
+            std::vector<uint8_t> payload(net::frame_payload_length(header));
+            receive_all(payload.data(), payload.size());
+            return payload;
+        }
+    };
+}
+
+#endif
@@ -5,7 +5,9 @@
 #include <any>
 #include <stdexcept>
 #include <cstring>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <functional>
 #include <unordered_map>
@@ -24,9 +26,18 @@
 #include <variant>
 #include <future>
 #include <thread>
+#include <atomic>
 #include <sstream>
 #include <cctype>
 #include "json.hpp"
+#include "deadline_timer.hpp"
+#include "thread_pool.hpp"
+#include "argument_pack.hpp"
+#include "json_codec.hpp"
+#include "json_sax.hpp"
+#include "param_index.hpp"
+#include "serializable.hpp"
+#include "span.hpp"
 
 namespace rpc {
     // 自定义异常类
@@ -36,7 +47,8 @@ namespace rpc {
             FUNCTION_NOT_FOUND,
             TYPE_MISMATCH,
             ARGUMENT_ERROR,
-            TIMEOUT_ERROR
+            TIMEOUT_ERROR,
+            OVERLOAD_ERROR
         };
 
         RpcException(ErrorType type, const std::string& message)
@@ -60,60 +72,147 @@ namespace rpc {
         return name;
     }
 
+    // 协作式取消令牌：调用超时后被置位，长时间运行的函数应定期检查
+    class CancellationToken {
+    public:
+        CancellationToken() : cancelled_(std::make_shared<std::atomic<bool>>(false)) {}
+
+        // 永远不会被取消的令牌，不分配内存（用于内联执行）
+        static CancellationToken none() { return CancellationToken(nullptr); }
+
+        bool is_cancelled() const {
+            return cancelled_ && cancelled_->load(std::memory_order_relaxed);
+        }
+
+        void cancel() const {
+            if (cancelled_) {
+                cancelled_->store(true, std::memory_order_relaxed);
+            }
+        }
+
+        void throw_if_cancelled() const {
+            if (is_cancelled()) {
+                throw RpcException(RpcException::ErrorType::TIMEOUT_ERROR, "Function call cancelled");
+            }
+        }
+
+    private:
+        explicit CancellationToken(std::nullptr_t) {}
+
+        std::shared_ptr<std::atomic<bool>> cancelled_;
+    };
+
+    // 函数执行方式
+    enum class ExecutionMode {
+        POOLED,  // 在线程池中执行，受超时控制
+        INLINE   // 在调用线程上直接执行，适用于不阻塞的轻量函数，无超时
+    };
+
     namespace detail {
-        // 类型转换辅助函数
+        // 判断函数的最后一个参数是否为取消令牌（该参数由框架注入，不参与命名参数匹配）
+        template<typename... Args>
+        struct takes_cancellation_token : std::false_type {};
+
+        template<typename Last>
+        struct takes_cancellation_token<Last>
+            : std::is_same<std::decay_t<Last>, CancellationToken> {};
+
+        template<typename First, typename Second, typename... Rest>
+        struct takes_cancellation_token<First, Second, Rest...>
+            : takes_cancellation_token<Second, Rest...> {};
+
+        template<typename... Args>
+        inline constexpr bool takes_cancellation_token_v = takes_cancellation_token<Args...>::value;
+
+        // 取前 N 个参数的类型信息
+        template<typename Tuple, std::size_t... I>
+        std::vector<const std::type_info*> param_type_list(std::index_sequence<I...>) {
+            return {&typeid(std::tuple_element_t<I, Tuple>)...};
+        }
+
+        // 前 N 个参数（去掉引用和 const）组成的元组类型，即参数包中的存储类型
+        template<typename Tuple, typename Seq>
+        struct named_args_tuple;
+
+        template<typename Tuple, std::size_t... I>
+        struct named_args_tuple<Tuple, std::index_sequence<I...>> {
+            using type = std::tuple<std::decay_t<std::tuple_element_t<I, Tuple>>...>;
+        };
+
+        template<size_t N, typename... Args>
+        using named_args_tuple_t = typename named_args_tuple<std::tuple<Args...>, std::make_index_sequence<N>>::type;
+
+        // 把 JSON 值直接写入参数槽位，注册时按参数类型实例化
         template<typename T>
-        std::any json_to_any(const nlohmann::json& j) {
-            if constexpr (std::is_same_v<T, int>) {
-                return std::make_any<int>(j.get<int>());
-            } else if constexpr (std::is_same_v<T, long>) {
-                return std::make_any<long>(j.get<long>());
-            } else if constexpr (std::is_same_v<T, float>) {
-                return std::make_any<float>(j.get<float>());
-            } else if constexpr (std::is_same_v<T, double>) {
-                return std::make_any<double>(j.get<double>());
-            } else if constexpr (std::is_same_v<T, bool>) {
-                return std::make_any<bool>(j.get<bool>());
-            } else if constexpr (std::is_same_v<T, std::string>) {
-                return std::make_any<std::string>(j.get<std::string>());
-            } else if constexpr (std::is_same_v<T, std::vector<int>>) {
-                return std::make_any<std::vector<int>>(j.get<std::vector<int>>());
-            } else if constexpr (std::is_same_v<T, std::vector<std::string>>) {
-                return std::make_any<std::vector<std::string>>(j.get<std::vector<std::string>>());
+        void json_to_slot(const nlohmann::json& j, void* slot) {
+            // 视图类型只能引用二进制请求缓冲区，JSON 解码后没有可引用的存储
+            if constexpr (is_json_decodable_v<T> && !serialization::is_borrowed_v<T>) {
+                j.get_to(*static_cast<T*>(slot));
             } else {
                 throw RpcException(
                     RpcException::ErrorType::TYPE_MISMATCH,
-                    "Unsupported type conversion from JSON"
+                    "Unsupported type conversion from JSON: " + demangle(typeid(T).name())
                 );
             }
         }
 
-        // 类型转换函数
-        std::any convert_json_to_any(const nlohmann::json& j, const std::type_info& type) {
-            if (type == typeid(int)) {
-                return json_to_any<int>(j);
-            } else if (type == typeid(long)) {
-                return json_to_any<long>(j);
-            } else if (type == typeid(float)) {
-                return json_to_any<float>(j);
-            } else if (type == typeid(double)) {
-                return json_to_any<double>(j);
-            } else if (type == typeid(bool)) {
-                return json_to_any<bool>(j);
-            } else if (type == typeid(std::string)) {
-                return json_to_any<std::string>(j);
-            } else if (type == typeid(std::vector<int>)) {
-                return json_to_any<std::vector<int>>(j);
-            } else if (type == typeid(std::vector<std::string>)) {
-                return json_to_any<std::vector<std::string>>(j);
+        using JsonSlotDecoder = void (*)(const nlohmann::json&, void*);
+
+        // 为参数元组中的每个参数生成解码函数指针
+        template<typename Tuple, std::size_t... I>
+        std::vector<JsonSlotDecoder> make_json_decoders(std::index_sequence<I...>) {
+            return {&json_to_slot<std::tuple_element_t<I, Tuple>>...};
+        }
+
+        // 从二进制参数流中读取下一个值写入参数槽位
+        template<typename T>
+        void binary_to_slot(serialization::Deserializer& in, void* slot) {
+            if constexpr (serialization::is_decodable_v<T> && std::is_nothrow_move_constructible_v<T>) {
+                // 重新构造而不是赋值：pmr 容器移动赋值时不传播分配器，会把数据复制到默认资源
+                T value = in.deserialize<T>();
+                T* target = static_cast<T*>(slot);
+                target->~T();
+                new (target) T(std::move(value));
+            } else if constexpr (serialization::is_decodable_v<T>) {
+                *static_cast<T*>(slot) = in.deserialize<T>();
+            } else {
+                throw RpcException(
+                    RpcException::ErrorType::TYPE_MISMATCH,
+                    "Unsupported type for binary decoding: " + demangle(typeid(T).name())
+                );
+            }
+        }
+
+        using BinarySlotDecoder = void (*)(serialization::Deserializer&, void*);
+
+        template<typename Tuple, std::size_t... I>
+        std::vector<BinarySlotDecoder> make_binary_decoders(std::index_sequence<I...>) {
+            return {&binary_to_slot<std::tuple_element_t<I, Tuple>>...};
+        }
+
+        // 把返回值编码为二进制，紧凑编码时先写入格式标记
+        template<typename Ret>
+        void any_to_binary(const std::any& value, std::vector<uint8_t>& out, serialization::WireFormat format) {
+            if constexpr (std::is_void_v<Ret>) {
+                // 无返回值时输出为空
+            } else if constexpr (serialization::is_encodable_v<Ret>) {
+                const Ret& result = std::any_cast<const Ret&>(value);
+                if (format == serialization::WireFormat::COMPACT) {
+                    out.push_back(serialization::COMPACT_MARKER);
+                    serialization::serialize_value<serialization::WireFormat::COMPACT>(out, result);
+                } else {
+                    serialization::serialize_value(out, result);
+                }
             } else {
                 throw RpcException(
                     RpcException::ErrorType::TYPE_MISMATCH,
-                    "Unsupported type: " + demangle(type.name())
+                    "Unsupported return type for binary encoding: " + demangle(typeid(Ret).name())
                 );
             }
         }
 
+        using BinaryResultEncoder = void (*)(const std::any&, std::vector<uint8_t>&, serialization::WireFormat);
+
         // 分割字符串
         inline std::vector<std::string> split(const std::string& s, char delimiter) {
             std::vector<std::string> tokens;
@@ -131,66 +230,326 @@ namespace rpc {
         }
     }
 
+    // 执行器配置
+    struct ExecutorOptions {
+        size_t worker_count = ThreadPool::default_thread_count();
+        size_t max_queue_depth = 1024;
+    };
+
+    // 注册时分配的稳定函数编号，可代替函数名在线路上传输
+    using FunctionId = uint32_t;
+
     class RpcProvider {
     public:
+        explicit RpcProvider(const ExecutorOptions& options = ExecutorOptions())
+            : executor_(options.worker_count, options.max_queue_depth) {}
+
+        // 已解码的参数 + 取消令牌 -> 返回值
+        using Invoker = std::function<std::any(ArgumentPack&, const CancellationToken&)>;
+
         // 存储函数签名信息的结构
         struct FunctionInfo {
+            std::string name;
             const std::type_info* returnType;
             std::vector<const std::type_info*> paramTypes;
             std::vector<std::string> paramNames;
-            std::function<std::any(const std::vector<std::any>&)> func;
+            // 参数名 -> 参数下标的索引，注册时构建
+            detail::ParamIndex paramIndex;
+            // 每个参数在参数包元组中的偏移量
+            std::vector<size_t> paramOffsets;
+            // 每个参数的 JSON 解码函数
+            std::vector<detail::JsonSlotDecoder> paramDecoders;
+            // 每个参数的二进制解码函数（按注册顺序读取）
+            std::vector<detail::BinarySlotDecoder> paramBinaryDecoders;
+            // 二进制参数中是否有引用请求缓冲区的视图（std::string_view / ArrayView）
+            bool borrowsArguments = false;
+            // 返回值的二进制编码函数
+            detail::BinaryResultEncoder encodeResult = nullptr;
+            // 每个参数的 SAX 接收器（流式解码路径使用）
+            std::vector<detail::SaxSink> paramSinks;
+            // 在参数包中构造该函数的参数元组
+            void (*construct_args)(ArgumentPack&) = nullptr;
+            // 共享所有权：超时后仍在后台运行的调用不依赖注册表中的条目
+            std::shared_ptr<const Invoker> func;
             std::chrono::milliseconds timeout{5000};
+            ExecutionMode mode = ExecutionMode::POOLED;
         };
 
-        // 注册函数
+        // 注册函数，返回函数编号；同名函数重新注册时沿用原编号
         template <typename Ret, typename... Args>
-        void register_function(const std::string& name, 
+        FunctionId register_function(const std::string& name, 
                             std::function<Ret(Args...)> func,
                             const std::vector<std::string>& param_names,
-                            std::chrono::milliseconds timeout = std::chrono::milliseconds(5000)) {
+                            std::chrono::milliseconds timeout = std::chrono::milliseconds(5000),
+                            ExecutionMode mode = ExecutionMode::POOLED) {
             // 编译时类型检查
             static_assert((std::is_copy_constructible_v<Args> && ...), 
                         "All argument types must be copy constructible");
             static_assert(std::is_copy_constructible_v<Ret> || std::is_void_v<Ret>, 
                         "Return type must be copy constructible");
+            static_assert((std::is_default_constructible_v<std::decay_t<Args>> && ...),
+                        "All argument types must be default constructible");
+
+            // 最后一个参数为 CancellationToken 时由框架注入
+            constexpr bool with_token = detail::takes_cancellation_token_v<Args...>;
+            constexpr size_t named_count = sizeof...(Args) - (with_token ? 1 : 0);
+            using ArgTuple = detail::named_args_tuple_t<named_count, Args...>;
 
             // 检查参数名称数量是否匹配
-            if (param_names.size() != sizeof...(Args)) {
+            if (param_names.size() != named_count) {
                 throw RpcException(
                     RpcException::ErrorType::ARGUMENT_ERROR,
                     "Parameter names count mismatch"
                 );
             }
+            // 重复的参数名无法区分，按名称调用时必然缺少某个参数
+            for (size_t i = 0; i < param_names.size(); ++i) {
+                for (size_t j = i + 1; j < param_names.size(); ++j) {
+                    if (param_names[i] == param_names[j]) {
+                        throw RpcException(
+                            RpcException::ErrorType::ARGUMENT_ERROR,
+                            "Duplicate parameter name: " + param_names[i]
+                        );
+                    }
+                }
+            }
 
             FunctionInfo info;
+            info.name = name;
             info.returnType = &typeid(Ret);
-            info.paramTypes = {&typeid(Args)...};
+            info.paramTypes = detail::param_type_list<std::tuple<Args...>>(
+                std::make_index_sequence<named_count>{}
+            );
             info.paramNames = param_names;
+            info.paramIndex = detail::ParamIndex(param_names);
+            info.paramOffsets = ArgumentPack::slot_offsets<ArgTuple>();
+            info.paramDecoders = detail::make_json_decoders<ArgTuple>(std::make_index_sequence<named_count>{});
+            info.paramBinaryDecoders = detail::make_binary_decoders<ArgTuple>(
+                std::make_index_sequence<named_count>{}
+            );
+            info.encodeResult = &detail::any_to_binary<Ret>;
+            info.borrowsArguments = (serialization::is_borrowed_v<std::decay_t<Args>> || ...);
+            info.paramSinks = detail::make_sax_sinks<ArgTuple>(std::make_index_sequence<named_count>{});
+            info.construct_args = [](ArgumentPack& pack) { pack.emplace<ArgTuple>(); };
             info.timeout = timeout;
-            info.func = [func](const std::vector<std::any>& args) -> std::any {
-                if (args.size() != sizeof...(Args)) {
-                    throw RpcException(
-                        RpcException::ErrorType::ARGUMENT_ERROR,
-                        "Arguments count mismatch"
-                    );
+            info.mode = mode;
+            info.func = std::make_shared<const Invoker>(
+                [func](ArgumentPack& args, const CancellationToken& token) -> std::any {
+                    if (args.empty()) {
+                        throw RpcException(
+                            RpcException::ErrorType::ARGUMENT_ERROR,
+                            "Arguments count mismatch"
+                        );
+                    }
+                    return call_impl<Ret, Args...>(func, args.get<ArgTuple>(), token,
+                                                   std::make_index_sequence<named_count>{});
                 }
-                return call_impl<Ret, Args...>(func, args, std::make_index_sequence<sizeof...(Args)>{});
-            };
-            functions[name] = std::move(info);
+            );
+
+            auto it = function_ids.find(name);
+            if (it != function_ids.end()) {
+                functions[it->second] = std::move(info);
+                return it->second;
+            }
+            FunctionId id = static_cast<FunctionId>(functions.size());
+            functions.push_back(std::move(info));
+            function_ids.emplace(name, id);
+            return id;
+        }
+
+        // 按函数名查找函数编号
+        FunctionId function_id(const std::string& name) const {
+            auto it = function_ids.find(name);
+            if (it == function_ids.end()) {
+                throw RpcException(
+                    RpcException::ErrorType::FUNCTION_NOT_FOUND,
+                    "Function not found: " + name
+                );
+            }
+            return it->second;
         }
 
         // 通过 JSON 进行命名参数调用
         template <typename Ret>
         Ret call_function_named(const std::string& name, const nlohmann::json& named_args) {
-            auto it = functions.find(name);
-            if (it == functions.end()) {
+            return call_by_id<Ret>(function_id(name), named_args);
+        }
+
+        // 通过函数编号调用，分发只需一次带边界检查的数组访问
+        template <typename Ret>
+        Ret call_by_id(FunctionId id, const nlohmann::json& named_args) {
+            const auto& info = checked_function<Ret>(id);
+            return execute<Ret>(info, [&](ArgumentPack& args) {
+                decode_named_args(info, named_args, args);
+            });
+        }
+
+        // 直接解析 JSON 文本进行命名参数调用：SAX 流式解码，不构建整个 DOM，
+        // 参数值按下标直接写入参数槽位
+        template <typename Ret>
+        Ret call_function_json(const std::string& name, std::string_view json_text) {
+            return call_by_id_json<Ret>(function_id(name), json_text);
+        }
+
+        template <typename Ret>
+        Ret call_by_id_json(FunctionId id, std::string_view json_text) {
+            const auto& info = checked_function<Ret>(id);
+            return execute<Ret>(info, [&](ArgumentPack& args) {
+                decode_json_text(info, json_text, args);
+            });
+        }
+
+        // 二进制调用：参数按注册顺序以 serialization 格式编码，
+        // 直接解码进参数包，返回值以 serialize_value 编码（void 返回空缓冲区）
+        std::vector<uint8_t> call_function_binary(const std::string& name, ByteSpan args) {
+            return call_function_binary(function_id(name), args);
+        }
+
+        std::vector<uint8_t> call_function_binary(FunctionId id, ByteSpan args) {
+            std::vector<uint8_t> out;
+            call_function_binary(id, args, out);
+            return out;
+        }
+
+        // 返回值追加到调用方的缓冲区末尾，连接可以在多次调用间复用同一个发送缓冲区。
+        // 返回值使用与请求相同的线路格式（请求为紧凑编码时返回值也是紧凑编码）。
+        // 参数类型为 std::string_view 或 serialization::ArrayView<T> 时直接引用请求缓冲区，不复制；
+        // std::pmr::string / std::pmr::vector 参数从参数包的分配区分配，调用结束后整体释放
+        void call_function_binary(FunctionId id, ByteSpan args, std::vector<uint8_t>& out) {
+            const auto& info = checked_function(id);
+            ByteSpan source = args;
+            std::shared_ptr<const std::vector<uint8_t>> owned;
+            if (info.borrowsArguments && info.mode == ExecutionMode::POOLED) {
+                // 线程池中的调用在超时后可能比调用方活得更久，视图必须指向调用状态持有的副本
+                owned = std::make_shared<const std::vector<uint8_t>>(args.begin(), args.end());
+                source = *owned;
+            }
+            std::any result = execute_any(info, [&](ArgumentPack& pack) {
+                decode_binary_args(info, source, pack);
+            }, owned);
+            info.encodeResult(result, out, serialization::detect_format(args));
+        }
+
+        // 异步二进制调用的完成回调：成功时 error 为空、result 为返回值的编码，失败时 error 为异常
+        using BinaryCompletion = std::function<void(std::vector<uint8_t> result, std::exception_ptr error)>;
+
+        // 不等待线程池的二进制调用，编解码规则同 call_function_binary。
+        // 内联函数在返回前同步完成：返回值追加到 out，返回 true；函数不存在、参数错误、队列已满等错误直接抛出。
+        // 线程池中的函数返回 false，执行完毕或超时时在工作线程（或超时线程）上调用 done，恰好一次。
+        // 返回后调用方不必保留 args
+        bool call_function_binary_async(FunctionId id, ByteSpan args, std::vector<uint8_t>& out,
+                                        BinaryCompletion done) {
+            const auto& info = checked_function(id);
+            if (info.mode == ExecutionMode::INLINE) {
+                call_function_binary(id, args, out);
+                return true;
+            }
+
+            auto call = std::make_shared<PooledCall>();
+            ByteSpan source = args;
+            if (info.borrowsArguments) {
+                auto owned = std::make_shared<const std::vector<uint8_t>>(args.begin(), args.end());
+                source = *owned;
+                call->keep_alive = std::move(owned);
+            }
+            decode_binary_args(info, source, call->args);
+            call->func = info.func;
+            call->deadline = timer_.make_handle(DeadlineTimer::Clock::now() + info.timeout);
+            PooledCall* raw = call.get();
+            call->on_complete = [this, raw, done = std::move(done), encode = info.encodeResult,
+                                 format = serialization::detect_format(args)](std::any result, std::exception_ptr error) {
+                timer_.cancel(raw->deadline);
+                std::vector<uint8_t> encoded;
+                if (!error) {
+                    try {
+                        encode(result, encoded, format);
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+                }
+                done(std::move(encoded), error);
+            };
+
+            // 超时先到时取消令牌并以 TIMEOUT_ERROR 完成，之后工作线程的结果被丢弃
+            std::weak_ptr<PooledCall> weak = call;
+            timer_.schedule(call->deadline, [weak, name = info.name]() {
+                if (auto expired = weak.lock()) {
+                    expired->token.cancel();
+                    if (!expired->finished.exchange(true, std::memory_order_acq_rel)) {
+                        expired->on_complete({}, std::make_exception_ptr(RpcException(
+                            RpcException::ErrorType::TIMEOUT_ERROR, "Function call timed out: " + name)));
+                    }
+                }
+            });
+            if (!executor_.try_submit([call]() { run_pooled(*call); })) {
+                if (call->finished.exchange(true, std::memory_order_acq_rel)) {
+                    return false;  // 已经超时并完成
+                }
+                timer_.cancel(call->deadline);
+                throw RpcException(
+                    RpcException::ErrorType::OVERLOAD_ERROR,
+                    "Executor queue is full: " + info.name
+                );
+            }
+            return false;
+        }
+
+        // 处理请求对象 {"method": 函数名或函数编号, "params": {命名参数}}
+        template <typename Ret>
+        Ret call_request(const nlohmann::json& request) {
+            if (!request.is_object() || !request.contains("method")) {
+                throw RpcException(
+                    RpcException::ErrorType::ARGUMENT_ERROR,
+                    "Request must contain a method"
+                );
+            }
+
+            const auto& method = request["method"];
+            const auto& params = request.contains("params") ? request["params"] : empty_params();
+            if (method.is_number_unsigned()) {
+                return call_by_id<Ret>(method.get<FunctionId>(), params);
+            } else if (method.is_string()) {
+                return call_function_named<Ret>(method.get_ref<const std::string&>(), params);
+            }
+            throw RpcException(
+                RpcException::ErrorType::ARGUMENT_ERROR,
+                "Method must be a function name or id"
+            );
+        }
+
+        // 执行器（用于查询线程数与队列深度）
+        const ThreadPool& executor() const { return executor_; }
+
+        // 设置函数超时时间
+        void set_timeout(const std::string& name, std::chrono::milliseconds timeout) {
+            auto it = function_ids.find(name);
+            if (it != function_ids.end()) {
+                functions[it->second].timeout = timeout;
+            }
+        }
+
+        void set_timeout(FunctionId id, std::chrono::milliseconds timeout) {
+            if (id < functions.size()) {
+                functions[id].timeout = timeout;
+            }
+        }
+
+    private:
+        // 查找函数
+        const FunctionInfo& checked_function(FunctionId id) const {
+            if (id >= functions.size()) {
                 throw RpcException(
                     RpcException::ErrorType::FUNCTION_NOT_FOUND,
-                    "Function not found: " + name
+                    "Function id not found: " + std::to_string(id)
                 );
             }
+            return functions[id];
+        }
 
-            const auto& info = it->second;
+        // 查找函数并检查返回类型
+        template <typename Ret>
+        const FunctionInfo& checked_function(FunctionId id) const {
+            const auto& info = checked_function(id);
 
             // 检查返回类型
             if (*info.returnType != typeid(Ret)) {
@@ -201,55 +560,223 @@ namespace rpc {
                     " but got " + demangle(typeid(Ret).name())
                 );
             }
+            return info;
+        }
 
-            // 按照注册时的参数顺序重新排列参数
-            std::vector<std::any> ordered_args;
-            ordered_args.reserve(info.paramNames.size());
+        // 解码参数并按函数的执行方式调用
+        template <typename Ret, typename Decode>
+        Ret execute(const FunctionInfo& info, Decode&& decode) {
+            std::any result = execute_any(info, std::forward<Decode>(decode));
+            if constexpr (std::is_void_v<Ret>) {
+                return;
+            } else {
+                return unwrap_result<Ret>(result);
+            }
+        }
+
+        // keep_alive 在线程池调用结束前保持有效（用于参数视图引用的缓冲区）
+        template <typename Decode>
+        std::any execute_any(const FunctionInfo& info, Decode&& decode,
+                             std::shared_ptr<const void> keep_alive = nullptr) {
+            const auto& name = info.name;
 
+            // 内联函数直接在调用线程上执行，参数包位于栈上，不经过 future 和超时机制
+            if (info.mode == ExecutionMode::INLINE) {
+                ArgumentPack args;
+                decode(args);
+                return (*info.func)(args, CancellationToken::none());
+            }
+
+            // 提交到线程池执行，调用状态持有参数包、函数和取消令牌的所有权，
+            // 超时后调用方直接返回，任务在后台分离运行
+            auto call = std::make_shared<PooledCall>();
+            call->keep_alive = std::move(keep_alive);
+            decode(call->args);
+            call->func = info.func;
+            auto future = call->promise.get_future();
+            if (!executor_.try_submit([call]() { run_pooled(*call); })) {
+                throw RpcException(
+                    RpcException::ErrorType::OVERLOAD_ERROR,
+                    "Executor queue is full: " + name
+                );
+            }
+
+            // 等待结果，带超时（promise 的 future 析构时不会阻塞）
+            if (future.wait_for(info.timeout) == std::future_status::timeout) {
+                call->token.cancel();
+                throw RpcException(
+                    RpcException::ErrorType::TIMEOUT_ERROR,
+                    "Function call timed out: " + name
+                );
+            }
+            return future.get();
+        }
+
+        // 在线程池中执行的调用的共享状态
+        struct PooledCall {
+            // 参数包之前声明：参数中的视图析构前缓冲区仍然有效
+            std::shared_ptr<const void> keep_alive;
+            ArgumentPack args;
+            CancellationToken token;
+            std::shared_ptr<const Invoker> func;
+            std::promise<std::any> promise;
+            // 异步调用：结果交给 on_complete 而不是 promise，finished 保证只完成一次
+            std::function<void(std::any, std::exception_ptr)> on_complete;
+            std::atomic<bool> finished{false};
+            DeadlineTimer::Handle deadline;
+        };
+
+        static void run_pooled(PooledCall& call) {
+            std::any result;
+            std::exception_ptr error;
+            try {
+                // 排队期间已超时的调用不再执行
+                call.token.throw_if_cancelled();
+                result = (*call.func)(call.args, call.token);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            if (call.on_complete) {
+                if (!call.finished.exchange(true, std::memory_order_acq_rel)) {
+                    call.on_complete(std::move(result), error);
+                }
+            } else if (error) {
+                call.promise.set_exception(error);
+            } else {
+                call.promise.set_value(std::move(result));
+            }
+        }
+
+        // 遍历一次命名参数对象，按参数名索引把值解码到参数包的槽位中
+        static void decode_named_args(const FunctionInfo& info, const nlohmann::json& named_args,
+                                      ArgumentPack& args) {
+            info.construct_args(args);
+            detail::ParamSet seen;
+            if (named_args.is_object()) {
+                for (auto it = named_args.begin(); it != named_args.end(); ++it) {
+                    int index = info.paramIndex.find(it.key());
+                    if (index < 0) {
+                        continue;
+                    }
+                    size_t i = static_cast<size_t>(index);
+                    seen.insert(i);
+
+                    try {
+                        // 转换参数类型
+                        info.paramDecoders[i](*it, args.slot(info.paramOffsets[i]));
+                    } catch (const nlohmann::json::exception& e) {
+                        throw RpcException(
+                            RpcException::ErrorType::TYPE_MISMATCH,
+                            "JSON conversion error for parameter '" + info.paramNames[i] + "': " + e.what()
+                        );
+                    }
+                }
+            }
+
+            // 检查参数是否存在
             for (size_t i = 0; i < info.paramNames.size(); ++i) {
-                const auto& param_name = info.paramNames[i];
-                
-                // 检查参数是否存在
-                if (!named_args.contains(param_name)) {
+                if (!seen.contains(i)) {
                     throw RpcException(
                         RpcException::ErrorType::ARGUMENT_ERROR,
-                        "Missing argument: " + param_name
+                        "Missing argument: " + info.paramNames[i]
                     );
                 }
+            }
+        }
 
+        // 按注册顺序把二进制参数解码到参数包的槽位中
+        static void decode_binary_args(const FunctionInfo& info, ByteSpan bytes, ArgumentPack& args) {
+            info.construct_args(args);
+            serialization::Deserializer in(bytes);
+            in.set_memory_resource(args.arena());
+            for (size_t i = 0; i < info.paramBinaryDecoders.size(); ++i) {
                 try {
-                    // 转换参数类型
-                    ordered_args.push_back(
-                        detail::convert_json_to_any(named_args[param_name], *info.paramTypes[i])
+                    info.paramBinaryDecoders[i](in, args.slot(info.paramOffsets[i]));
+                } catch (const RpcException&) {
+                    throw;
+                } catch (const std::runtime_error& e) {
+                    throw RpcException(
+                        RpcException::ErrorType::TYPE_MISMATCH,
+                        "Binary decode error for parameter '" + info.paramNames[i] + "': " + e.what()
                     );
+                }
+            }
+            if (!in.at_end()) {
+                throw RpcException(
+                    RpcException::ErrorType::ARGUMENT_ERROR,
+                    "Unexpected trailing bytes in binary arguments for " + info.name
+                );
+            }
+        }
+
+        // SAX 解码时的参数上下文
+        struct SaxContext {
+            const FunctionInfo& info;
+            ArgumentPack& args;
+
+            const detail::SaxSink& sink(size_t index) const { return info.paramSinks[index]; }
+
+            void* slot(size_t index) { return args.slot(info.paramOffsets[index]); }
+
+            int lookup(const std::string& key) const { return info.paramIndex.find(key); }
+
+            void decode_dom(size_t index, const nlohmann::json& value) {
+                try {
+                    info.paramDecoders[index](value, slot(index));
                 } catch (const nlohmann::json::exception& e) {
                     throw RpcException(
                         RpcException::ErrorType::TYPE_MISMATCH,
-                        "JSON conversion error for parameter '" + param_name + "': " + e.what()
+                        "JSON conversion error for parameter '" + info.paramNames[index] + "': " + e.what()
                     );
                 }
             }
 
+            [[noreturn]] void type_error(size_t index) const {
+                throw RpcException(
+                    RpcException::ErrorType::TYPE_MISMATCH,
+                    "JSON conversion error for parameter '" + info.paramNames[index] +
+                    "': type must be " + info.paramSinks[index].expected
+                );
+            }
+
+            [[noreturn]] void not_an_object() const {
+                throw RpcException(
+                    RpcException::ErrorType::ARGUMENT_ERROR,
+                    "Arguments must be a JSON object"
+                );
+            }
+        };
+
+        // 流式解析 JSON 文本，把参数直接解码到参数包的槽位中
+        static void decode_json_text(const FunctionInfo& info, std::string_view json_text,
+                                     ArgumentPack& args) {
+            info.construct_args(args);
+            SaxContext context{info, args};
+            detail::SaxArgumentHandler<SaxContext> handler(context);
             try {
-                // 创建异步任务
-                auto future = std::async(std::launch::async, [&]() {
-                    return info.func(ordered_args);
-                });
+                nlohmann::json::sax_parse(json_text.begin(), json_text.end(), &handler);
+            } catch (const nlohmann::json::exception& e) {
+                throw RpcException(
+                    RpcException::ErrorType::ARGUMENT_ERROR,
+                    "JSON parse error: " + std::string(e.what())
+                );
+            }
 
-                // 等待结果，带超时
-                if (future.wait_for(info.timeout) == std::future_status::timeout) {
+            for (size_t i = 0; i < info.paramNames.size(); ++i) {
+                if (!handler.seen(i)) {
                     throw RpcException(
-                        RpcException::ErrorType::TIMEOUT_ERROR,
-                        "Function call timed out: " + name
+                        RpcException::ErrorType::ARGUMENT_ERROR,
+                        "Missing argument: " + info.paramNames[i]
                     );
                 }
+            }
+        }
 
-                if constexpr (std::is_void_v<Ret>) {
-                    future.get();
-                    return;
-                } else {
-                    return std::any_cast<Ret>(future.get());
-                }
+        // 从 std::any 中取出返回值
+        template <typename Ret>
+        static Ret unwrap_result(std::any& result) {
+            try {
+                return std::any_cast<Ret>(std::move(result));
             } catch (const std::bad_any_cast& e) {
                 throw RpcException(
                     RpcException::ErrorType::TYPE_MISMATCH,
@@ -258,28 +785,42 @@ namespace rpc {
             }
         }
 
-        // 设置函数超时时间
-        void set_timeout(const std::string& name, std::chrono::milliseconds timeout) {
-            auto it = functions.find(name);
-            if (it != functions.end()) {
-                it->second.timeout = timeout;
-            }
+        static const nlohmann::json& empty_params() {
+            static const nlohmann::json params = nlohmann::json::object();
+            return params;
         }
 
-    private:
-        // 存储注册的函数
-        std::unordered_map<std::string, FunctionInfo> functions;
+        // 存储注册的函数，下标即函数编号
+        std::vector<FunctionInfo> functions;
+        // 函数名到函数编号的索引
+        std::unordered_map<std::string, FunctionId> function_ids;
+
+        // 异步调用的超时；在线程池之前声明，线程池析构时执行的剩余任务仍可以取消定时
+        DeadlineTimer timer_;
 
-        // 辅助函数：展开参数并调用函数
-        template<typename Ret, typename... Args, std::size_t... I>
+        // 执行注册函数的工作线程池
+        ThreadPool executor_;
+
+        // 辅助函数：展开参数并调用函数，参数从参数包中移出
+        template<typename Ret, typename... Args, typename ArgTuple, std::size_t... I>
         static std::any call_impl(const std::function<Ret(Args...)>& func,
-                                const std::vector<std::any>& args,
+                                ArgTuple& args,
+                                const CancellationToken& token,
                                 std::index_sequence<I...>) {
-            if constexpr (std::is_void_v<Ret>) {
-                func(std::any_cast<std::decay_t<Args>>(args[I])...);
-                return std::any();
+            if constexpr (detail::takes_cancellation_token_v<Args...>) {
+                if constexpr (std::is_void_v<Ret>) {
+                    func(std::move(std::get<I>(args))..., token);
+                    return std::any();
+                } else {
+                    return func(std::move(std::get<I>(args))..., token);
+                }
             } else {
-                return func(std::any_cast<std::decay_t<Args>>(args[I])...);
+                if constexpr (std::is_void_v<Ret>) {
+                    func(std::move(std::get<I>(args))...);
+                    return std::any();
+                } else {
+                    return func(std::move(std::get<I>(args))...);
+                }
             }
         }
     };
@@ -292,4 +833,9 @@ namespace rpc {
 #define REGISTER_FUNCTION(server, name, func, ...) \
     server.register_function(name, std::function(func), PARAM_NAMES(__VA_ARGS__))
 
+// 用于注册内联执行的轻量函数的宏
+#define REGISTER_INLINE_FUNCTION(server, name, func, ...) \
+    server.register_function(name, std::function(func), PARAM_NAMES(__VA_ARGS__), \
+                             std::chrono::milliseconds(0), rpc::ExecutionMode::INLINE)
+
 #endif
\ No newline at end of file
@@ -0,0 +1,133 @@
+#ifndef __RPC_RPC_SERVER_H__
+#define __RPC_RPC_SERVER_H__
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <memory>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include "epoll_loop.hpp"
+#include "event_loop.hpp"
+#include "io_uring_loop.hpp"
+#include "rpc_provider.hpp"
+
+namespace rpc {
+    // TCP 服务器前端：每个事件循环一个线程、一个 SO_REUSEPORT 监听套接字，
+    // 请求帧按 frame.hpp 的格式解析后交给 RpcProvider::call_function_binary。
+    // I/O 后端由 ServerOptions::io_engine 选择，默认优先 io_uring，内核不支持时退回 epoll。
+    // 设置 ServerOptions::unix_path 时改为监听 Unix 域套接字，供本机的 sidecar 使用。
+    // 所有函数必须在 start() 之前注册。
+    // 内联函数在事件循环线程上直接执行；线程池中执行的函数不阻塞事件循环，同一连接上最多
+    // ServerOptions::max_in_flight 个请求同时执行，响应按完成顺序发送，客户端按请求编号配对
+    class RpcServer {
+    public:
+        explicit RpcServer(RpcProvider& provider, ServerOptions options = ServerOptions())
+            : provider_(provider), options_(std::move(options)) {}
+
+        RpcServer(const RpcServer&) = delete;
+        RpcServer& operator=(const RpcServer&) = delete;
+
+        ~RpcServer() { stop(); }
+
+        // 创建监听套接字并启动事件循环线程；端口被占用、某个事件循环无法使用选定的 I/O 后端等错误
+        // 抛出 std::system_error，已创建的事件循环随之释放
+        void start() {
+            try {
+                if (!options_.unix_path.empty()) {
+                    start_unix();
+                } else {
+                    size_t count = options_.loop_count ? options_.loop_count : ThreadPool::default_thread_count();
+                    int first = net::open_listener(options_, options_.port);
+                    port_ = net::local_port(first);
+                    loops_.push_back(make_loop(first));
+                    for (size_t i = 1; i < count; ++i) {
+                        loops_.push_back(make_loop(net::open_listener(options_, port_)));
+                    }
+                }
+            } catch (...) {
+                loops_.clear();
+                engine_ = IoEngine::AUTO;
+                throw;
+            }
+            for (size_t i = 0; i < loops_.size(); ++i) {
+                threads_.emplace_back([loop = loops_[i].get()]() { loop->run(); });
+                if (options_.pin_loops) {
+                    cpu_set_t cpus;
+                    CPU_ZERO(&cpus);
+                    CPU_SET(i % ThreadPool::default_thread_count(), &cpus);
+                    pthread_setaffinity_np(threads_.back().native_handle(), sizeof(cpus), &cpus);
+                }
+            }
+        }
+
+        // 停止所有事件循环并关闭连接
+        void stop() {
+            for (auto& loop : loops_) {
+                loop->stop();
+            }
+            for (auto& thread : threads_) {
+                thread.join();
+            }
+            threads_.clear();
+            loops_.clear();
+            if (unix_bound_) {
+                unlink(options_.unix_path.c_str());
+                unix_bound_ = false;
+            }
+        }
+
+        // 实际监听的端口（监听 Unix 域套接字时为 0）
+        uint16_t port() const { return port_; }
+
+        size_t loop_count() const { return loops_.size(); }
+
+        // 实际使用的 I/O 后端（start() 之后有效）
+        IoEngine io_engine() const { return engine_; }
+
+    private:
+        RpcProvider& provider_;
+        ServerOptions options_;
+        uint16_t port_ = 0;
+        IoEngine engine_ = IoEngine::AUTO;
+        bool unix_bound_ = false;
+        std::vector<std::unique_ptr<net::EventLoop>> loops_;
+        std::vector<std::thread> threads_;
+
+        // Unix 域套接字需要 recvmsg 接收描述符，只由一个 epoll 事件循环服务
+        void start_unix() {
+            if (options_.io_engine == IoEngine::IO_URING) {
+                throw std::system_error(ENOTSUP, std::generic_category(),
+                                        "io_uring engine does not serve Unix domain sockets");
+            }
+            int fd = net::open_unix_listener(options_.unix_path, options_.backlog);
+            unix_bound_ = true;
+            engine_ = IoEngine::EPOLL;
+            loops_.push_back(std::make_unique<net::EpollLoop>(provider_, options_, fd));
+        }
+
+        // 创建事件循环并转交监听套接字的所有权。AUTO 只在第一个事件循环上选择后端，
+        // 之后的事件循环必须使用同一后端，不能用时失败而不是混用
+        std::unique_ptr<net::EventLoop> make_loop(int listen_fd) {
+            IoEngine engine = loops_.empty() ? options_.io_engine : engine_;
+            if (engine != IoEngine::EPOLL) {
+                try {
+                    auto loop = std::make_unique<net::UringLoop>(provider_, options_, listen_fd);
+                    engine_ = IoEngine::IO_URING;
+                    return loop;
+                } catch (const std::system_error&) {
+                    if (engine == IoEngine::IO_URING) {
+                        close(listen_fd);
+                        throw;
+                    }
+                }
+            }
+            engine_ = IoEngine::EPOLL;
+            return std::make_unique<net::EpollLoop>(provider_, options_, listen_fd);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef __RPC_SERIALIZABLE_H__
+#define __RPC_SERIALIZABLE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "serialization.hpp"
+
+// 自动生成 Serializer<T>：
+//
+//   struct Point { float x; float y; std::string name; };
+//   RPC_SERIALIZABLE(Point, x, y, name)
+//
+// 必须在全局命名空间中使用（与手写的 Serializer<T> 特化一样）。
+// 成员按列出的顺序逐个以带类型标识的格式编码；若结构体平凡可复制、成员都是数值或
+// 同样可以整块复制的结构体、没有填充字节且列出了全部成员，则整个结构体作为一块内存 memcpy。
+namespace rpc {
+namespace serialization {
+namespace detail {
+    template<typename C, typename M>
+    M member_type_of(M C::*);
+
+    template<auto Member>
+    using member_type_t = decltype(member_type_of(Member));
+
+    template<typename T, auto... Members>
+    struct MemberSerializer {
+        static constexpr bool is_serializable = true;
+
+        // 成员本身可以整块复制：线路格式的数值，或同样可以整块复制的结构体及其 std::array。
+        // 指针、bool、枚举等不行——前者的值离开本进程就没有意义，后者的表示取决于 ABI
+        template<typename M>
+        static constexpr bool is_pod_member = is_wire_scalar_v<M> || is_pod_element_v<M>;
+
+        // 平凡可复制、每个成员都可以整块复制，且成员大小之和等于结构体大小（没有填充字节，也没有遗漏成员）；
+        // 整体复制保留本机字节序，大端主机上逐成员编码
+        static constexpr bool is_pod_layout =
+            !wire_needs_swap && std::is_trivially_copyable_v<T> &&
+            (is_pod_member<member_type_t<Members>> && ...) &&
+            sizeof(T) == (sizeof(member_type_t<Members>) + ...);
+
+        // 按成员类型顺序计算的布局哈希（POD_BLOB 校验收发双方的定义是否一致）
+        static constexpr uint64_t layout_hash() {
+            uint64_t hash = layout_hash_basis;
+            ((hash = layout_hash_combine(hash, pod_layout_hash<member_type_t<Members>>())), ...);
+            return layout_hash_combine(hash, sizeof(T));
+        }
+
+        static size_t get_size(const T& value) {
+            if constexpr (is_pod_layout) {
+                return sizeof(T);
+            } else {
+                return (get_serialized_size(value.*Members) + ...);
+            }
+        }
+
+        static void serialize(std::vector<uint8_t>& buffer, const T& value) {
+            if constexpr (is_pod_layout) {
+                const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+                buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+            } else {
+                (serialize_value(buffer, value.*Members), ...);
+            }
+        }
+
+        static T deserialize(Deserializer& in) {
+            if constexpr (is_pod_layout) {
+                return in.read_raw<T>();
+            } else {
+                T value{};
+                ((value.*Members = in.deserialize<member_type_t<Members>>()), ...);
+                return value;
+            }
+        }
+    };
+}
+}
+}
+
+// 对每个参数应用 macro(Type, 参数)，最多 16 个
+#define RPC_SERIALIZATION_EXPAND(x) x
+#define RPC_SERIALIZATION_MEMBER(Type, m) &Type::m
+#define RPC_SERIALIZATION_FE_1(M, T, a) M(T, a)
+#define RPC_SERIALIZATION_FE_2(M, T, a, ...) M(T, a), RPC_SERIALIZATION_EXPAND(RPC_SERIALIZATION_FE_1(M, T, __VA_ARGS__))
+#define RPC_SERIALIZATION_FE_3(M, T, a, ...) M(T, a), RPC_SERIALIZATION_EXPAND(RPC_SERIALIZATION_FE_2(M, T, __VA_ARGS__))
+#define RPC_SERIALIZATION_FE_4(M, T, a, ...) M(T, a), RPC_SERIALIZATION_EXPAND(RPC_SERIALIZATION_FE_3(M, T, __VA_ARGS__))
+#define RPC_SERIALIZATION_FE_5(M, T, a, ...) M(T, a), RPC_SERIALIZATION_EXPAND(RPC_SERIALIZATION_FE_4(M, T, __VA_ARGS__))
+#define RPC_SERIALIZATION_FE_6(M, T, a, ...) M(T, a), RPC_SERIALIZATION_EXPAND(RPC_SERIALIZATION_FE_5(M, T, __VA_ARGS__))
+#define RPC_SERIALIZATION_FE_7(M, T, a, ...) M(T, a), RPC_SERIALIZATION_EXPAND(RPC_SERIALIZATION_FE_6(M, T, __VA_ARGS__))
+#define RPC_SERIALIZATION_FE_8(M, T, a, ...) M(T, a), RPC_SERIALIZATION_EXPAND(RPC_SERIALIZATION_FE_7(M, T, __VA_ARGS__))
+#define RPC_SERIALIZATION_FE_9(M, T, a, ...) M(T, a), RPC_SERIALIZATION_EXPAND(RPC_SERIALIZATION_FE_8(M, T, __VA_ARGS__))
+#define RPC_SERIALIZATION_FE_10(M, T, a, ...) M(T, a), RPC_SERIALIZATION_EXPAND(RPC_SERIALIZATION_FE_9(M, T, __VA_ARGS__))
+#define RPC_SERIALIZATION_FE_11(M, T, a, ...) M(T, a), RPC_SERIALIZATION_EXPAND(RPC_SERIALIZATION_FE_10(M, T, __VA_ARGS__))
+#define RPC_SERIALIZATION_FE_12(M, T, a, ...) M(T, a), RPC_SERIALIZATION_EXPAND(RPC_SERIALIZATION_FE_11(M, T, __VA_ARGS__))
+#define RPC_SERIALIZATION_FE_13(M, T, a, ...) M(T, a), RPC_SERIALIZATION_EXPAND(RPC_SERIALIZATION_FE_12(M, T, __VA_ARGS__))
+#define RPC_SERIALIZATION_FE_14(M, T, a, ...) M(T, a), RPC_SERIALIZATION_EXPAND(RPC_SERIALIZATION_FE_13(M, T, __VA_ARGS__))
+#define RPC_SERIALIZATION_FE_15(M, T, a, ...) M(T, a), RPC_SERIALIZATION_EXPAND(RPC_SERIALIZATION_FE_14(M, T, __VA_ARGS__))
+#define RPC_SERIALIZATION_FE_16(M, T, a, ...) M(T, a), RPC_SERIALIZATION_EXPAND(RPC_SERIALIZATION_FE_15(M, T, __VA_ARGS__))
+#define RPC_SERIALIZATION_PICK(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, NAME, ...) NAME
+#define RPC_SERIALIZATION_FOR_EACH(M, T, ...) \
+    RPC_SERIALIZATION_EXPAND(RPC_SERIALIZATION_PICK(__VA_ARGS__, \
+        RPC_SERIALIZATION_FE_16, RPC_SERIALIZATION_FE_15, RPC_SERIALIZATION_FE_14, RPC_SERIALIZATION_FE_13, \
+        RPC_SERIALIZATION_FE_12, RPC_SERIALIZATION_FE_11, RPC_SERIALIZATION_FE_10, RPC_SERIALIZATION_FE_9, \
+        RPC_SERIALIZATION_FE_8, RPC_SERIALIZATION_FE_7, RPC_SERIALIZATION_FE_6, RPC_SERIALIZATION_FE_5, \
+        RPC_SERIALIZATION_FE_4, RPC_SERIALIZATION_FE_3, RPC_SERIALIZATION_FE_2, RPC_SERIALIZATION_FE_1)(M, T, __VA_ARGS__))
+
+#define RPC_SERIALIZABLE(Type, ...) \
+    template<> \
+    struct rpc::serialization::Serializer<Type> \
+        : rpc::serialization::detail::MemberSerializer<Type, \
+              RPC_SERIALIZATION_FOR_EACH(RPC_SERIALIZATION_MEMBER, Type, __VA_ARGS__)> {};
+
+#endif
@@ -1,3 +1,6 @@
+#ifndef __RPC_SERIALIZATION_H__
+#define __RPC_SERIALIZATION_H__
+
 #include <string>
 #include <any>
 #include <vector>
@@ -6,6 +9,8 @@
 #include <cxxabi.h>
 #include <array>
 #include <list>
+#include <map>
+#include <unordered_map>
 #include <memory>
 #include <algorithm>
 #include <chrono>
@@ -17,7 +22,15 @@
 #include <cstdio>
 #include <cstdint>
 #include <type_traits>
-#include <iostream>
+#include <string_view>
+#include <memory_resource>
+#include <stdexcept>
+#include <sys/uio.h>
+#include "span.hpp"
+#include "serialization_trace.hpp"
+#include "varint.hpp"
+#include "byte_order.hpp"
+#include "serialization_error.hpp"
 
 namespace rpc {
 namespace serialization {
@@ -60,6 +73,11 @@ namespace serialization {
             VECTOR_FLOAT32 = 49,
             VECTOR_FLOAT64 = 50,
 
+            // 容器类型：元素各自带类型标识
+            LIST = 60,      // 元素不是数值的数组（字符串、嵌套数组、结构体等）
+            MAP = 61,       // 键值对
+            POD_BLOB = 70,  // 平凡可复制结构体的数组：元素大小 + 布局哈希 + 原始字节
+
             // 自定义类型
             STRUCT = 100
         };
@@ -88,12 +106,184 @@ namespace serialization {
         template<typename T>
         struct is_std_vector : std::false_type {};
 
-        template<typename T>
-        struct is_std_vector<std::vector<T>> : std::true_type {};
+        template<typename T, typename A>
+        struct is_std_vector<std::vector<T, A>> : std::true_type {};
 
         template<typename T>
         inline constexpr bool is_std_vector_v = is_std_vector<T>::value;
 
+        // 检查是否为字符串（std::string 或 std::pmr::string 等其他分配器的字符串）
+        template<typename T>
+        struct is_std_string : std::false_type {};
+
+        template<typename Traits, typename A>
+        struct is_std_string<std::basic_string<char, Traits, A>> : std::true_type {};
+
+        template<typename T>
+        inline constexpr bool is_std_string_v = is_std_string<T>::value;
+
+        // 线路格式直接支持的标量类型
+        template<typename T>
+        inline constexpr bool is_wire_scalar_v =
+            std::is_same_v<T, uint8_t> || std::is_same_v<T, int8_t> ||
+            std::is_same_v<T, uint16_t> || std::is_same_v<T, int16_t> ||
+            std::is_same_v<T, uint32_t> || std::is_same_v<T, int32_t> ||
+            std::is_same_v<T, uint64_t> || std::is_same_v<T, int64_t> ||
+            std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+        template<typename T, typename = void>
+        struct is_wire_sequence : std::false_type {};
+
+        template<typename T>
+        struct is_wire_sequence<T, std::enable_if_t<std::is_array_v<T>>>
+            : std::bool_constant<is_wire_scalar_v<std::remove_extent_t<T>>> {};
+
+        template<typename T, size_t N>
+        struct is_wire_sequence<std::array<T, N>> : std::bool_constant<is_wire_scalar_v<T>> {};
+
+        template<typename T, typename A>
+        struct is_wire_sequence<std::vector<T, A>> : std::bool_constant<is_wire_scalar_v<T>> {};
+
+        // 检查是否为 std::map / std::unordered_map
+        template<typename T>
+        struct is_std_map : std::false_type {};
+
+        template<typename K, typename V, typename C, typename A>
+        struct is_std_map<std::map<K, V, C, A>> : std::true_type {};
+
+        template<typename K, typename V, typename H, typename E, typename A>
+        struct is_std_map<std::unordered_map<K, V, H, E, A>> : std::true_type {};
+
+        template<typename T>
+        inline constexpr bool is_std_map_v = is_std_map<T>::value;
+
+        // Serializer<T> 声明了无填充的内存布局（RPC_SERIALIZABLE 生成）
+        template<typename T, typename = void>
+        struct has_pod_layout : std::false_type {};
+
+        template<typename T>
+        struct has_pod_layout<T, std::void_t<decltype(Serializer<T>::is_pod_layout)>>
+            : std::bool_constant<Serializer<T>::is_pod_layout> {};
+
+        // 可以整块 memcpy 的数组元素：布局固定、没有填充字节的结构体，或数值 / 此类元素组成的 std::array。
+        // 整块复制的数据保持本机字节序，所以只在本机字节序与线路字节序一致时启用
+        template<typename T>
+        struct is_pod_element : std::bool_constant<!wire_needs_swap && has_pod_layout<T>::value> {};
+
+        template<typename E, size_t N>
+        struct is_pod_element<std::array<E, N>>
+            : std::bool_constant<!wire_needs_swap && (is_wire_scalar_v<E> || is_pod_element<E>::value)> {};
+
+        template<typename T>
+        inline constexpr bool is_pod_element_v = is_pod_element<T>::value;
+
+        template<typename T>
+        inline constexpr bool is_sequence_v = std::is_array_v<T> || is_std_array_v<T> || is_std_vector_v<T>;
+
+        template<typename T>
+        struct sequence_element {
+            using type = void;
+        };
+
+        template<typename E, size_t N>
+        struct sequence_element<E[N]> {
+            using type = E;
+        };
+
+        template<typename E, size_t N>
+        struct sequence_element<std::array<E, N>> {
+            using type = E;
+        };
+
+        template<typename E, typename A>
+        struct sequence_element<std::vector<E, A>> {
+            using type = E;
+        };
+
+        // 元素可整块复制、按 POD_BLOB 编码的数组
+        template<typename T>
+        inline constexpr bool is_pod_blob_v =
+            is_sequence_v<T> && is_pod_element_v<typename sequence_element<T>::type>;
+
+        // 元素不是数值、按 LIST 编码的数组
+        template<typename T>
+        inline constexpr bool is_list_v =
+            is_sequence_v<T> && !is_wire_sequence<T>::value && !is_pod_blob_v<T>;
+
+        // 能否用 serialize_value 编码
+        template<typename T>
+        struct is_encodable : std::bool_constant<
+            is_wire_scalar_v<T> || is_std_string_v<T> || is_serializable_v<T>> {};
+
+        template<typename E, typename A>
+        struct is_encodable<std::vector<E, A>> : is_encodable<E> {};
+
+        template<typename E, size_t N>
+        struct is_encodable<std::array<E, N>> : is_encodable<E> {};
+
+        template<typename E, size_t N>
+        struct is_encodable<E[N]> : is_encodable<E> {};
+
+        template<typename K, typename V, typename C, typename A>
+        struct is_encodable<std::map<K, V, C, A>>
+            : std::bool_constant<is_encodable<K>::value && is_encodable<V>::value> {};
+
+        template<typename K, typename V, typename H, typename E, typename A>
+        struct is_encodable<std::unordered_map<K, V, H, E, A>>
+            : std::bool_constant<is_encodable<K>::value && is_encodable<V>::value> {};
+
+        template<typename T>
+        inline constexpr bool is_encodable_v = is_encodable<T>::value;
+
+        template<typename T>
+        class ArrayView;
+
+        class Deserializer;
+
+        // Serializer<T> 是否提供 static T deserialize(Deserializer&)
+        template<typename T, typename = void>
+        struct has_struct_deserialize : std::false_type {};
+
+        template<typename T>
+        struct has_struct_deserialize<T, std::void_t<decltype(
+            Serializer<T>::deserialize(std::declval<Deserializer&>())
+        )>> : std::is_same<decltype(Serializer<T>::deserialize(std::declval<Deserializer&>())), T> {};
+
+        template<typename T>
+        struct is_wire_view : std::false_type {};
+
+        template<typename T>
+        struct is_wire_view<ArrayView<T>> : std::bool_constant<is_wire_scalar_v<T> || is_pod_element_v<T>> {};
+
+        // 能否用 Deserializer 解码；容器的元素不能是引用源缓冲区的视图
+        template<typename T>
+        struct is_decodable : std::bool_constant<
+            is_wire_scalar_v<T> || is_std_string_v<T> ||
+            std::is_same_v<T, std::string_view> || is_wire_view<T>::value ||
+            (is_serializable_v<T> && has_struct_deserialize<T>::value)> {};
+
+        template<typename T>
+        struct is_owned_decodable
+            : std::bool_constant<is_decodable<T>::value && !std::is_same_v<T, std::string_view> &&
+                                 !is_wire_view<T>::value> {};
+
+        template<typename E, typename A>
+        struct is_decodable<std::vector<E, A>> : is_owned_decodable<E> {};
+
+        template<typename E, size_t N>
+        struct is_decodable<std::array<E, N>> : is_owned_decodable<E> {};
+
+        template<typename K, typename V, typename C, typename A>
+        struct is_decodable<std::map<K, V, C, A>>
+            : std::bool_constant<is_owned_decodable<K>::value && is_owned_decodable<V>::value> {};
+
+        template<typename K, typename V, typename H, typename E, typename A>
+        struct is_decodable<std::unordered_map<K, V, H, E, A>>
+            : std::bool_constant<is_owned_decodable<K>::value && is_owned_decodable<V>::value> {};
+
+        template<typename T>
+        inline constexpr bool is_decodable_v = is_decodable<T>::value;
+
         // 获取数组元素类型
         template<typename T>
         struct array_traits {
@@ -109,11 +299,11 @@ namespace serialization {
             static const T* data(const std::array<T, N>& arr) { return arr.data(); }
         };
 
-        template<typename T>
-        struct array_traits<std::vector<T>> {
+        template<typename T, typename A>
+        struct array_traits<std::vector<T, A>> {
             using element_type = T;
-            static size_t size(const std::vector<T>& vec) { return vec.size(); }
-            static const T* data(const std::vector<T>& vec) { return vec.data(); }
+            static size_t size(const std::vector<T, A>& vec) { return vec.size(); }
+            static const T* data(const std::vector<T, A>& vec) { return vec.data(); }
         };
 
         // 获取数组元素类型对应的DataType
@@ -161,18 +351,56 @@ namespace serialization {
             else if constexpr (std::is_same_v<T, int64_t>) return DataType::SINT64;
             else if constexpr (std::is_same_v<T, float>) return DataType::FLOAT32;
             else if constexpr (std::is_same_v<T, double>) return DataType::FLOAT64;
-            else if constexpr (std::is_same_v<T, std::string>) return DataType::STRING;
+            else if constexpr (is_std_string_v<T>) return DataType::STRING;
             else if constexpr (is_serializable_v<T>) return DataType::STRUCT;
             else static_assert(!std::is_same_v<T,T>, "Unsupported type");
         }
 
+        // POD 元素的布局哈希：由成员类型、数组长度和结构体大小组成，
+        // 收发双方的结构体定义不一致时解码会失败，而不是把字节错位地解释成数据
+        constexpr uint64_t layout_hash_combine(uint64_t hash, uint64_t value) {
+            return (hash ^ value) * 1099511628211ull;
+        }
+
+        inline constexpr uint64_t layout_hash_basis = 14695981039346656037ull;
+
+        template<typename T>
+        constexpr uint64_t pod_layout_hash() {
+            if constexpr (is_wire_scalar_v<T>) {
+                return layout_hash_combine(layout_hash_basis, static_cast<uint64_t>(get_data_type<T>()));
+            } else if constexpr (is_std_array_v<T>) {
+                uint64_t hash = layout_hash_combine(layout_hash_basis, static_cast<uint64_t>(DataType::POD_BLOB));
+                hash = layout_hash_combine(hash, pod_layout_hash<typename T::value_type>());
+                return layout_hash_combine(hash, std::tuple_size_v<T>);
+            } else if constexpr (has_pod_layout<T>::value) {
+                return Serializer<T>::layout_hash();
+            } else {
+                // 没有登记成员的平凡类型只能校验大小和对齐
+                return layout_hash_combine(layout_hash_combine(layout_hash_basis, sizeof(T)), alignof(T));
+            }
+        }
+
+        // POD_BLOB 头部中类型标识和元素个数之后的部分：元素大小 + 布局哈希
+        inline constexpr size_t pod_blob_descriptor_size = sizeof(uint32_t) + sizeof(uint64_t);
+
         // 基础类型的序列化大小
         template<typename T>
         size_t get_serialized_size(const T& value) {
             if constexpr (std::is_arithmetic_v<T>) {
                 return sizeof(DataType) + sizeof(T);  // type + data
-            } else if constexpr (std::is_same_v<T, std::string>) {
-                return sizeof(DataType) + sizeof(size_t) + value.size();  // type + length + data
+            } else if constexpr (is_std_string_v<T>) {
+                return sizeof(DataType) + sizeof(uint32_t) + value.size();  // type + length + data
+            } else if constexpr (is_pod_blob_v<T>) {
+                using Traits = array_traits<T>;
+                return sizeof(DataType) + sizeof(uint32_t) + pod_blob_descriptor_size +
+                       Traits::size(value) * sizeof(typename Traits::element_type);  // type + count + descriptor + data
+            } else if constexpr (is_list_v<T>) {
+                using Traits = array_traits<T>;
+                size_t size = sizeof(DataType) + sizeof(uint32_t);  // type + length + elements
+                for (size_t i = 0; i < Traits::size(value); ++i) {
+                    size += get_serialized_size(Traits::data(value)[i]);
+                }
+                return size;
             } else if constexpr (std::is_array_v<T> || is_std_array_v<T>) {
                 using Traits = array_traits<T>;
                 return sizeof(DataType) + sizeof(uint32_t) + 
@@ -181,6 +409,12 @@ namespace serialization {
                 using Traits = array_traits<T>;
                 return sizeof(DataType) + sizeof(uint32_t) + 
                        Traits::size(value) * sizeof(typename Traits::element_type);  // type + length + data
+            } else if constexpr (is_std_map_v<T>) {
+                size_t size = sizeof(DataType) + sizeof(uint32_t);  // type + count + pairs
+                for (const auto& [key, item] : value) {
+                    size += get_serialized_size(key) + get_serialized_size(item);
+                }
+                return size;
             } else if constexpr (is_serializable_v<T>) {
                 return sizeof(DataType) + Serializer<T>::get_size(value);  // type + data
             } else {
@@ -192,83 +426,182 @@ namespace serialization {
         // 获取参数包的总序列化大小
         template<typename... Args>
         size_t get_total_size(const Args&... args) {
-            return (get_serialized_size(args) + ...);
+            return (size_t(0) + ... + get_serialized_size(args));
         }
 
-        // 序列化单个值到vector
+        // 线路格式。紧凑编码的消息以 COMPACT_MARKER 开头，其中 16/32/64 位整数（包括数组元素）
+        // 和所有长度前缀使用 LEB128 varint，有符号数先做 zig-zag；8 位整数和浮点数保持原样。
+        // 定长消息的第一个字节总是 DataType，不会与标记冲突，旧格式的消息无需任何改动即可识别。
+        enum class WireFormat : uint8_t { FIXED, COMPACT };
+
+        inline constexpr uint8_t COMPACT_MARKER = 0xC1;
+
+        inline WireFormat detect_format(ByteSpan bytes) {
+            return !bytes.empty() && bytes[0] == COMPACT_MARKER ? WireFormat::COMPACT : WireFormat::FIXED;
+        }
+
+        // 紧凑编码下使用 varint 的整数类型
         template<typename T>
-        void serialize_value(std::vector<uint8_t>& buffer, const T& value) {
-            if constexpr (std::is_arithmetic_v<T>) {
+        inline constexpr bool is_varint_v = std::is_integral_v<T> && sizeof(T) > 1;
+
+        // 追加到 std::vector 末尾；用 insert 追加，不会先零填充再 memcpy
+        struct VectorWriter {
+            std::vector<uint8_t>& buffer;
+
+            void write(const void* data, size_t size) {
+                const uint8_t* bytes = static_cast<const uint8_t*>(data);
+                buffer.insert(buffer.end(), bytes, bytes + size);
+            }
+
+            // 字符串、数组等大块负载
+            void write_payload(const void* data, size_t size) { write(data, size); }
+        };
+
+        // 写入调用方提供的定长缓冲区
+        struct RawWriter {
+            span<uint8_t> out;
+            size_t position = 0;
+
+            void write(const void* data, size_t size) {
+                if (size > out.size() - position) {
+                    throw std::runtime_error("Output buffer too small for serialized data");
+                }
+                std::memcpy(out.data() + position, data, size);
+                position += size;
+            }
+
+            void write_payload(const void* data, size_t size) { write(data, size); }
+        };
+
+        // 类型标识 + 长度一次写出
+        template<WireFormat Format, typename Writer>
+        void write_header(Writer& writer, DataType type, uint32_t length) {
+            uint8_t header[sizeof(DataType) + varint::max_bytes<uint32_t>()];
+            std::memcpy(header, &type, sizeof(DataType));
+            if constexpr (Format == WireFormat::COMPACT) {
+                writer.write(header, sizeof(DataType) + varint::encode(length, header + sizeof(DataType)));
+            } else {
+                byte_order::store(header + sizeof(DataType), length);
+                writer.write(header, sizeof(DataType) + sizeof(uint32_t));
+            }
+        }
+
+        // 本机字节序与线路字节序不同时，数组按块交换字节序后写出（不能直接引用原始内存）
+        template<typename Writer, typename T>
+        void write_swapped(Writer& writer, const T* values, size_t count) {
+            constexpr size_t chunk = 4096 / sizeof(T);
+            alignas(32) uint8_t bytes[chunk * sizeof(T)];
+            for (size_t i = 0; i < count; i += chunk) {
+                size_t n = std::min(count - i, chunk);
+                byte_order::to_wire(bytes, values + i, n);
+                writer.write(bytes, n * sizeof(T));
+            }
+        }
+
+        // 把整数数组逐个编码为 varint，按块写出
+        template<typename Writer, typename T>
+        void write_varints(Writer& writer, const T* values, size_t count) {
+            constexpr size_t chunk = 64;
+            uint8_t bytes[chunk * varint::max_bytes<T>()];
+            for (size_t i = 0; i < count; i += chunk) {
+                size_t n = 0;
+                size_t end = std::min(count, i + chunk);
+                for (size_t j = i; j < end; ++j) {
+                    n += varint::encode(values[j], bytes + n);
+                }
+                writer.write(bytes, n);
+            }
+        }
+
+        // 按线路格式把单个值写入 Writer
+        template<WireFormat Format = WireFormat::FIXED, typename Writer, typename T>
+        void encode_value(Writer& writer, const T& value) {
+            if constexpr (Format == WireFormat::COMPACT && is_varint_v<T>) {
+                uint8_t bytes[sizeof(DataType) + varint::max_bytes<T>()];
                 DataType type = get_data_type<T>();
-                size_t old_size = buffer.size();
-                buffer.resize(old_size + sizeof(DataType) + sizeof(T));
-                memcpy(buffer.data() + old_size, &type, sizeof(DataType));
-                memcpy(buffer.data() + old_size + sizeof(DataType), &value, sizeof(T));
-            } else if constexpr (std::is_same_v<T, std::string>) {
-                DataType type = DataType::STRING;
-                size_t len = value.size();
-                uint32_t len_fixed = static_cast<uint32_t>(len);
-                size_t old_size = buffer.size();
-                buffer.resize(old_size + sizeof(DataType) + sizeof(uint32_t) + len);
-                memcpy(buffer.data() + old_size, &type, sizeof(DataType));
-                memcpy(buffer.data() + old_size + sizeof(DataType), &len_fixed, sizeof(uint32_t));
-                memcpy(buffer.data() + old_size + sizeof(DataType) + sizeof(uint32_t), value.data(), len);
-            } else if constexpr (std::is_array_v<T> || is_std_array_v<T>) {
+                std::memcpy(bytes, &type, sizeof(DataType));
+                writer.write(bytes, sizeof(DataType) + varint::encode(value, bytes + sizeof(DataType)));
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                uint8_t bytes[sizeof(DataType) + sizeof(T)];
+                DataType type = get_data_type<T>();
+                std::memcpy(bytes, &type, sizeof(DataType));
+                byte_order::store(bytes + sizeof(DataType), value);
+                writer.write(bytes, sizeof(bytes));
+            } else if constexpr (is_std_string_v<T>) {
+                write_header<Format>(writer, DataType::STRING, static_cast<uint32_t>(value.size()));
+                writer.write_payload(value.data(), value.size());
+            } else if constexpr (is_pod_blob_v<T>) {
                 using Traits = array_traits<T>;
                 using ElementType = typename Traits::element_type;
-                
-                DataType type = get_array_data_type<ElementType>();
-                uint32_t len = Traits::size(value);
-                
-                size_t old_size = buffer.size();
-                buffer.resize(old_size + sizeof(DataType) + sizeof(uint32_t) + len * sizeof(ElementType));
-                
-                // 写入类型
-                memcpy(buffer.data() + old_size, &type, sizeof(DataType));
-                old_size += sizeof(DataType);
-                
-                // 写入长度
-                memcpy(buffer.data() + old_size, &len, sizeof(uint32_t));
-                old_size += sizeof(uint32_t);
-                
-                // 写入数据
-                memcpy(buffer.data() + old_size, Traits::data(value), len * sizeof(ElementType));
-            } else if constexpr (is_std_vector_v<T>) {
+                uint32_t len = static_cast<uint32_t>(Traits::size(value));
+                write_header<Format>(writer, DataType::POD_BLOB, len);
+
+                uint8_t descriptor[pod_blob_descriptor_size];
+                uint32_t element_size = sizeof(ElementType);
+                uint64_t hash = pod_layout_hash<ElementType>();
+                byte_order::store(descriptor, element_size);
+                byte_order::store(descriptor + sizeof(uint32_t), hash);
+                writer.write(descriptor, sizeof(descriptor));
+
+                // 整个数组一次复制（分散/聚集输出时直接引用）
+                writer.write_payload(Traits::data(value), len * sizeof(ElementType));
+            } else if constexpr (is_list_v<T>) {
+                using Traits = array_traits<T>;
+                uint32_t len = static_cast<uint32_t>(Traits::size(value));
+                write_header<Format>(writer, DataType::LIST, len);
+                for (uint32_t i = 0; i < len; ++i) {
+                    encode_value<Format>(writer, Traits::data(value)[i]);
+                }
+            } else if constexpr (is_std_map_v<T>) {
+                write_header<Format>(writer, DataType::MAP, static_cast<uint32_t>(value.size()));
+                for (const auto& [key, item] : value) {
+                    encode_value<Format>(writer, key);
+                    encode_value<Format>(writer, item);
+                }
+            } else if constexpr (std::is_array_v<T> || is_std_array_v<T> || is_std_vector_v<T>) {
                 using Traits = array_traits<T>;
                 using ElementType = typename Traits::element_type;
-                
-                DataType type = get_vector_data_type<ElementType>();
-                uint32_t len = Traits::size(value);
-                
-                size_t old_size = buffer.size();
-                buffer.resize(old_size + sizeof(DataType) + sizeof(uint32_t) + len * sizeof(ElementType));
-                
-                // 写入类型
-                memcpy(buffer.data() + old_size, &type, sizeof(DataType));
-                old_size += sizeof(DataType);
-                
-                // 写入长度
-                memcpy(buffer.data() + old_size, &len, sizeof(uint32_t));
-                old_size += sizeof(uint32_t);
-                
-                // 写入数据
-                memcpy(buffer.data() + old_size, Traits::data(value), len * sizeof(ElementType));
+
+                DataType type = is_std_vector_v<T> ? get_vector_data_type<ElementType>()
+                                                   : get_array_data_type<ElementType>();
+                uint32_t len = static_cast<uint32_t>(Traits::size(value));
+                write_header<Format>(writer, type, len);
+                if constexpr (Format == WireFormat::COMPACT && is_varint_v<ElementType>) {
+                    write_varints(writer, Traits::data(value), len);
+                } else if constexpr (wire_needs_swap && sizeof(ElementType) > 1) {
+                    write_swapped(writer, Traits::data(value), len);
+                } else {
+                    writer.write_payload(Traits::data(value), len * sizeof(ElementType));
+                }
             } else if constexpr (is_serializable_v<T>) {
                 DataType type = DataType::STRUCT;
-                size_t old_size = buffer.size();
-                buffer.resize(old_size + sizeof(DataType));
-                memcpy(buffer.data() + old_size, &type, sizeof(DataType));
-                Serializer<T>::serialize(buffer, value);
+                writer.write(&type, sizeof(DataType));
+                if constexpr (std::is_same_v<Writer, VectorWriter>) {
+                    Serializer<T>::serialize(writer.buffer, value);
+                } else {
+                    // Serializer<T> 的接口只接受 std::vector，先写入临时缓冲区
+                    std::vector<uint8_t> scratch;
+                    scratch.reserve(Serializer<T>::get_size(value));
+                    Serializer<T>::serialize(scratch, value);
+                    writer.write(scratch.data(), scratch.size());
+                }
             } else {
                 static_assert(!std::is_same_v<T,T>, "Unsupported type");
             }
         }
 
+        // 序列化单个值到vector
+        template<WireFormat Format = WireFormat::FIXED, typename T>
+        void serialize_value(std::vector<uint8_t>& buffer, const T& value) {
+            VectorWriter writer{buffer};
+            encode_value<Format>(writer, value);
+        }
+
         template<typename ...Args>
-        std::vector<uint8_t> serialize(Args... args) {
+        std::vector<uint8_t> serialize(const Args&... args) {
             // 计算总大小
             size_t total_size = get_total_size(args...);
-            printf("Total size: %zu\n", total_size);
+            RPC_SERIALIZATION_TRACE_SCOPE(SERIALIZE, "message", total_size);
             
             // 创建vector并预分配空间
             std::vector<uint8_t> buffer;
@@ -280,73 +613,362 @@ namespace serialization {
             return buffer;
         }
 
+        // 紧凑编码：以 COMPACT_MARKER 开头，Deserializer 根据标记自动切换解码方式
+        template<typename ...Args>
+        std::vector<uint8_t> serialize_compact(const Args&... args) {
+            size_t total_size = get_total_size(args...);
+            RPC_SERIALIZATION_TRACE_SCOPE(SERIALIZE, "compact message", total_size);
+
+            // 定长编码的大小作为预留容量的估计值
+            std::vector<uint8_t> buffer;
+            buffer.reserve(1 + total_size);
+            buffer.push_back(COMPACT_MARKER);
+            (serialize_value<WireFormat::COMPACT>(buffer, args), ...);
+            RPC_SERIALIZATION_TRACE_BYTES(buffer.size());
+            return buffer;
+        }
+
+        // 追加到已有缓冲区末尾，复用其容量（例如每个连接一个发送缓冲区）
+        template<typename ...Args>
+        void serialize_into(std::vector<uint8_t>& buffer, const Args&... args) {
+            size_t total_size = get_total_size(args...);
+            RPC_SERIALIZATION_TRACE_SCOPE(SERIALIZE, "message", total_size);
+            buffer.reserve(buffer.size() + total_size);
+            (serialize_value(buffer, args), ...);
+        }
+
+        // 写入调用方提供的内存（栈缓冲区、arena 等），返回写入的字节数；空间不足时抛出异常
+        template<typename ...Args>
+        size_t serialize_into(span<uint8_t> out, const Args&... args) {
+            RPC_SERIALIZATION_TRACE_SCOPE(SERIALIZE, "message", get_total_size(args...));
+            RawWriter writer{out};
+            (encode_value(writer, args), ...);
+            return writer.position;
+        }
+
+        // 分散/聚集输出：类型标识、长度和小值复制进内部缓冲区，
+        // 不小于 inline_threshold 字节的字符串和数组负载直接引用调用方的内存。
+        // 生成的 iovec 列表可以一次交给 writev / sendmsg，被引用的值在发送完成前必须保持有效。
+        class GatherList {
+        public:
+            static constexpr size_t default_inline_threshold = 256;
+
+            explicit GatherList(size_t inline_threshold = default_inline_threshold)
+                : inline_threshold_(inline_threshold) {}
+
+            template<typename ...Args>
+            void append(const Args&... args) {
+                RPC_SERIALIZATION_TRACE_SCOPE(SERIALIZE, "gather", get_total_size(args...));
+                Writer writer{*this};
+                (encode_value(writer, args), ...);
+            }
+
+            // 生成 iovec 列表；在下一次 append / clear 之前有效
+            const std::vector<iovec>& iovecs() {
+                iovecs_.clear();
+                iovecs_.reserve(segments_.size());
+                for (const Segment& segment : segments_) {
+                    const uint8_t* base = segment.external ? segment.data : arena_.data() + segment.offset;
+                    iovecs_.push_back(iovec{const_cast<uint8_t*>(base), segment.length});
+                }
+                return iovecs_;
+            }
+
+            // 所有片段的总字节数
+            size_t size_bytes() const { return size_bytes_; }
+
+            // 引用调用方内存的片段数
+            size_t external_segments() const {
+                return static_cast<size_t>(std::count_if(segments_.begin(), segments_.end(),
+                    [](const Segment& segment) { return segment.external; }));
+            }
+
+            // 拼接成连续缓冲区（调试和测试使用）
+            std::vector<uint8_t> flatten() const {
+                std::vector<uint8_t> out;
+                out.reserve(size_bytes_);
+                for (const Segment& segment : segments_) {
+                    const uint8_t* base = segment.external ? segment.data : arena_.data() + segment.offset;
+                    out.insert(out.end(), base, base + segment.length);
+                }
+                return out;
+            }
+
+            void clear() {
+                arena_.clear();
+                segments_.clear();
+                iovecs_.clear();
+                size_bytes_ = 0;
+            }
+
+        private:
+            // 内部缓冲区片段只记录偏移量：arena_ 扩容后地址会变化，生成 iovec 时再换算
+            struct Segment {
+                bool external;
+                size_t offset;
+                const uint8_t* data;
+                size_t length;
+            };
+
+            struct Writer {
+                GatherList& list;
+
+                void write(const void* data, size_t size) {
+                    if (size == 0) return;
+                    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+                    if (list.segments_.empty() || list.segments_.back().external) {
+                        list.segments_.push_back(Segment{false, list.arena_.size(), nullptr, 0});
+                    }
+                    list.arena_.insert(list.arena_.end(), bytes, bytes + size);
+                    list.segments_.back().length += size;
+                    list.size_bytes_ += size;
+                }
+
+                void write_payload(const void* data, size_t size) {
+                    if (size < list.inline_threshold_) {
+                        write(data, size);
+                        return;
+                    }
+                    list.segments_.push_back(Segment{true, 0, static_cast<const uint8_t*>(data), size});
+                    list.size_bytes_ += size;
+                }
+            };
+
+            size_t inline_threshold_;
+            std::vector<uint8_t> arena_;
+            std::vector<Segment> segments_;
+            std::vector<iovec> iovecs_;
+            size_t size_bytes_ = 0;
+        };
+
+        // 只读数组视图：数据按元素类型对齐时直接指向源缓冲区（零拷贝），
+        // 未对齐时退回到自有的副本。视图的生命周期不能超过源缓冲区。
+        template<typename T>
+        class ArrayView {
+        public:
+            using value_type = T;
+
+            ArrayView() = default;
+
+            // 指向源缓冲区中的 count 个元素（线路字节序）；需要交换字节序时同样退回副本
+            ArrayView(const uint8_t* data, size_t count) {
+                bool needs_swap = wire_needs_swap && sizeof(T) > 1;
+                if (!needs_swap && reinterpret_cast<uintptr_t>(data) % alignof(T) == 0) {
+                    view_ = span<const T>(reinterpret_cast<const T*>(data), count);
+                } else {
+                    owned_.resize(count);
+                    byte_order::from_wire(owned_.data(), data, count);
+                    view_ = span<const T>(owned_.data(), count);
+                }
+            }
+
+            // 持有解码后的数据（例如紧凑编码的整数数组无法直接引用源缓冲区）
+            explicit ArrayView(std::vector<T>&& values) : owned_(std::move(values)) {
+                view_ = span<const T>(owned_.data(), owned_.size());
+            }
+
+            ArrayView(const ArrayView& other) { *this = other; }
+
+            ArrayView& operator=(const ArrayView& other) {
+                if (this != &other) {
+                    owned_ = other.owned_;
+                    view_ = other.borrowed() ? other.view_ : span<const T>(owned_.data(), owned_.size());
+                }
+                return *this;
+            }
+
+            ArrayView(ArrayView&& other) noexcept { *this = std::move(other); }
+
+            ArrayView& operator=(ArrayView&& other) noexcept {
+                if (this != &other) {
+                    bool borrowed = other.borrowed();
+                    owned_ = std::move(other.owned_);
+                    view_ = borrowed ? other.view_ : span<const T>(owned_.data(), owned_.size());
+                    other.view_ = span<const T>();
+                }
+                return *this;
+            }
+
+            const T* data() const { return view_.data(); }
+            size_t size() const { return view_.size(); }
+            bool empty() const { return view_.empty(); }
+            const T* begin() const { return view_.begin(); }
+            const T* end() const { return view_.end(); }
+            const T& operator[](size_t index) const { return view_[index]; }
+            span<const T> as_span() const { return view_; }
+
+            // 是否直接引用源缓冲区
+            bool borrowed() const { return owned_.empty() && !view_.empty(); }
+
+            std::vector<T> to_vector() const { return std::vector<T>(begin(), end()); }
+
+        private:
+            std::vector<T> owned_;
+            span<const T> view_;
+        };
+
+        template<typename T>
+        struct is_array_view : std::false_type {};
+
+        template<typename T>
+        struct is_array_view<ArrayView<T>> : std::true_type {};
+
+        template<typename T>
+        inline constexpr bool is_array_view_v = is_array_view<T>::value;
+
+        // 解码结果是否引用源缓冲区（调用方需保证缓冲区在使用期间有效）
+        template<typename T>
+        inline constexpr bool is_borrowed_v = std::is_same_v<T, std::string_view> || is_array_view_v<T>;
+
         // 反序列化接口
     class Deserializer {
     public:
         Deserializer(const std::vector<uint8_t>& buffer)
-            : buffer_(buffer), position_(0) {}
+            : Deserializer(ByteSpan(buffer)) {}
 
-        template<typename T>
-        T deserialize_value() {
-            if (position_ >= buffer_.size()) {
-                throw std::runtime_error("Buffer underflow");
+        // 以 COMPACT_MARKER 开头的消息按紧凑编码解码
+        Deserializer(ByteSpan buffer)
+            : data_(buffer.data()), size_(buffer.size()), position_(0),
+              format_(detect_format(buffer)), resource_(std::pmr::get_default_resource()) {
+            if (format_ == WireFormat::COMPACT) {
+                position_ = 1;
             }
+        }
 
-            DataType type;
-            std::memcpy(&type, buffer_.data() + position_, sizeof(DataType));
-            position_ += sizeof(DataType);
+        // 按指定格式解码，不检测标记字节（流式解码时标记已被调用方消费）
+        Deserializer(ByteSpan buffer, WireFormat format)
+            : data_(buffer.data()), size_(buffer.size()), position_(0), format_(format),
+              resource_(std::pmr::get_default_resource()) {}
 
-            
+        WireFormat format() const { return format_; }
 
+        // 解码 std::pmr::string / std::pmr::vector 等 pmr 容器时使用的内存资源。
+        // 指向按请求重置的单调分配区时，解码过程不再经过全局分配器；
+        // 解码结果的生命周期不能超过该资源。其他容器不受影响
+        void set_memory_resource(std::pmr::memory_resource* resource) { resource_ = resource; }
 
-            if constexpr (std::is_arithmetic_v<T>) {
-                validate_type(type, get_data_type<T>());
-                T value;
-                std::memcpy(&value, buffer_.data() + position_, sizeof(T));
+        std::pmr::memory_resource* memory_resource() const { return resource_; }
+
+        // 已读取的字节数
+        size_t position() const { return position_; }
+
+        // 是否已读完整个缓冲区
+        bool at_end() const { return position_ >= size_; }
+
+        template<typename T>
+        T deserialize_value() {
+            if constexpr (!std::is_arithmetic_v<T> && !is_std_string_v<T>) {
+                // 数组、容器、结构体和视图
+                return deserialize_element<T>();
+            } else if constexpr (is_varint_v<T>) {
+                validate_type(read_type(), get_data_type<T>());
+                if (format_ == WireFormat::COMPACT) {
+                    T value;
+                    position_ += varint::decode(data_ + position_, size_ - position_, value);
+                    return value;
+                }
+                require(sizeof(T));
+                T value = byte_order::load<T>(data_ + position_);
                 position_ += sizeof(T);
                 return value;
-            } else if constexpr (std::is_same_v<T, std::string>) {
-                validate_type(type, DataType::STRING);
-                uint32_t  length;
-                std::memcpy(&length, buffer_.data() + position_, sizeof(uint32_t));
-                position_ += sizeof(uint32_t);
-
-                // 调试输出
-                std::cout << "Deserialized string length: " << length << std::endl;
-
-                // 检查长度合法性
-                if (position_ + length > buffer_.size()) {
-                    throw std::runtime_error("String length exceeds buffer size");
-                }
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                validate_type(read_type(), get_data_type<T>());
+                require(sizeof(T));
+                T value = byte_order::load<T>(data_ + position_);
+                position_ += sizeof(T);
+                return value;
+            } else {
+                validate_type(read_type(), DataType::STRING);
+                uint32_t length = read_string_length();
+                RPC_SERIALIZATION_TRACE_SCOPE(DESERIALIZE, "string", length);
 
-                std::string value(reinterpret_cast<const char*>(buffer_.data() + position_), length);
+                T value(reinterpret_cast<const char*>(data_ + position_), length, allocator_for<T>());
                 position_ += length;
                 return value;
-            } else {
-                throw std::runtime_error("Unsupported type for deserialization");
             }
         }
 
+        // 零拷贝读取字符串，返回指向源缓冲区的视图
+        std::string_view deserialize_string_view() {
+            validate_type(read_type(), DataType::STRING);
+            uint32_t length = read_string_length();
+            std::string_view value(reinterpret_cast<const char*>(data_ + position_), length);
+            position_ += length;
+            return value;
+        }
+
+        template<typename T, typename Vector = std::vector<T>>
+        Vector deserialize_vector() {
+            uint32_t length = read_vector_header<T>();
+            Vector vec(length, allocator_for<Vector>());
+            if constexpr (is_varint_v<T>) {
+                if (format_ == WireFormat::COMPACT) {
+                    position_ += varint::decode_bulk(data_ + position_, size_ - position_, vec.data(), length);
+                    return vec;
+                }
+            }
+            byte_order::from_wire(vec.data(), data_ + position_, length);
+            position_ += length * sizeof(T);
+            return vec;
+        }
+
+        // 零拷贝读取数值数组或 POD 结构体数组：对齐时直接指向源缓冲区，否则退回复制。
+        // 紧凑编码的整数数组需要解码，视图持有解码结果
         template<typename T>
-        std::vector<T> deserialize_vector() {
-            if (position_ >= buffer_.size()) {
-                throw std::runtime_error("Buffer underflow");
+        ArrayView<T> deserialize_vector_view() {
+            uint32_t length;
+            if constexpr (is_pod_element_v<T>) {
+                length = read_pod_blob_header<T>();
+            } else {
+                if constexpr (is_varint_v<T>) {
+                    if (format_ == WireFormat::COMPACT) {
+                        return ArrayView<T>(deserialize_vector<T>());
+                    }
+                }
+                length = read_vector_header<T>();
             }
+            ArrayView<T> view(data_ + position_, length);
+            position_ += length * sizeof(T);
+            return view;
+        }
 
-            DataType type;
-            std::memcpy(&type, buffer_.data() + position_, sizeof(DataType));
-            position_ += sizeof(DataType);
+        // 读取定长数组（ARRAY_* 或 LIST），元素个数必须与 N 一致
+        template<typename T, size_t N>
+        void deserialize_into(T (&out)[N]) {
+            read_fixed_array(out, N);
+        }
 
-            validate_vector_type<T>(type);
+        template<typename T, size_t N>
+        void deserialize_into(std::array<T, N>& out) {
+            read_fixed_array(out.data(), N);
+        }
 
-            uint32_t length;
-            std::memcpy(&length, buffer_.data() + position_, sizeof(uint32_t));
-            position_ += sizeof(uint32_t);
+        // 按类型读取下一个值
+        template<typename T>
+        T deserialize() {
+            return deserialize_element<T>();
+        }
 
-            std::vector<T> vec(length);
-            std::memcpy(vec.data(), buffer_.data() + position_, length * sizeof(T));
-            position_ += length * sizeof(T);
-            return vec;
+        // 供 Serializer<T>::deserialize 读取不带类型标识的原始数据
+        template<typename T>
+        T read_raw() {
+            static_assert(std::is_trivially_copyable_v<T>, "read_raw requires a trivially copyable type");
+            require(sizeof(T));
+            T value;
+            if constexpr (std::is_arithmetic_v<T>) {
+                value = byte_order::load<T>(data_ + position_);
+            } else {
+                std::memcpy(&value, data_ + position_, sizeof(T));
+            }
+            position_ += sizeof(T);
+            return value;
+        }
+
+        ByteSpan read_bytes(size_t count) {
+            require(count);
+            ByteSpan bytes(data_ + position_, count);
+            position_ += count;
+            return bytes;
         }
 
         template<typename... Args>
@@ -355,8 +977,22 @@ namespace serialization {
         }
 
     private:
-        const std::vector<uint8_t>& buffer_;
+        const uint8_t* data_;
+        size_t size_;
         size_t position_;
+        WireFormat format_;
+        std::pmr::memory_resource* resource_;
+
+        // pmr 容器的分配器绑定到 resource_，其他分配器默认构造
+        template<typename Container>
+        typename Container::allocator_type allocator_for() const {
+            using Allocator = typename Container::allocator_type;
+            if constexpr (std::is_constructible_v<Allocator, std::pmr::memory_resource*>) {
+                return Allocator(resource_);
+            } else {
+                return Allocator();
+            }
+        }
 
         template<typename T>
         constexpr DataType get_data_type() {
@@ -388,6 +1024,55 @@ namespace serialization {
             else static_assert(!std::is_same_v<T, T>, "Unsupported vector element type");
         }
 
+        DataType read_type() {
+            require(sizeof(DataType));
+            DataType type;
+            std::memcpy(&type, data_ + position_, sizeof(DataType));
+            position_ += sizeof(DataType);
+            return type;
+        }
+
+        // 读取长度前缀（定长 uint32_t 或 varint）
+        uint32_t read_length() {
+            uint32_t length;
+            if (format_ == WireFormat::COMPACT) {
+                position_ += varint::decode(data_ + position_, size_ - position_, length);
+                return length;
+            }
+            require(sizeof(uint32_t));
+            length = byte_order::load<uint32_t>(data_ + position_);
+            position_ += sizeof(uint32_t);
+            return length;
+        }
+
+        // 读取字符串长度并检查内容是否完整
+        uint32_t read_string_length() {
+            uint32_t length = read_length();
+
+            // 检查长度合法性
+            require(length);
+            return length;
+        }
+
+        // 读取数组的类型和长度，并检查数据是否完整
+        template<typename T>
+        uint32_t read_vector_header() {
+            validate_vector_type<T>(read_type());
+            uint32_t length = read_length();
+
+            // 检查长度合法性（varint 元素至少占 1 字节）
+            size_t element_bytes = is_varint_v<T> && format_ == WireFormat::COMPACT ? 1 : sizeof(T);
+            require(static_cast<size_t>(length) * element_bytes);
+            return length;
+        }
+
+        // 检查剩余字节数是否足够
+        void require(size_t bytes) const {
+            if (size_ - position_ < bytes) {
+                throw BufferUnderflow(bytes - (size_ - position_));
+            }
+        }
+
         void validate_type(DataType actual, DataType expected) {
             if (actual != expected) {
                 throw std::runtime_error("Data type mismatch during deserialization");
@@ -406,16 +1091,141 @@ namespace serialization {
             return Tuple{deserialize_element<std::tuple_element_t<Is, Tuple>>()...};
         }
 
+        // 读取 LIST / MAP 的元素个数；每个元素至少占 2 字节（类型标识 + 数据）
+        uint32_t read_container_header(DataType expected) {
+            validate_type(read_type(), expected);
+            uint32_t length = read_length();
+            size_t min_bytes = expected == DataType::MAP ? 4 : 2;
+            require(static_cast<size_t>(length) * min_bytes);
+            return length;
+        }
+
+        // 读取 POD_BLOB 头部，校验元素大小、布局哈希和数据长度，返回元素个数
+        template<typename T>
+        uint32_t read_pod_blob_header() {
+            validate_type(read_type(), DataType::POD_BLOB);
+            uint32_t length = read_length();
+            require(pod_blob_descriptor_size);
+            uint32_t element_size = byte_order::load<uint32_t>(data_ + position_);
+            uint64_t hash = byte_order::load<uint64_t>(data_ + position_ + sizeof(uint32_t));
+            position_ += pod_blob_descriptor_size;
+            if (element_size != sizeof(T)) {
+                throw std::runtime_error("POD element size mismatch during deserialization");
+            }
+            if (hash != pod_layout_hash<T>()) {
+                throw std::runtime_error("POD element layout mismatch during deserialization");
+            }
+            require(static_cast<size_t>(length) * sizeof(T));
+            return length;
+        }
+
+        template<typename T, typename Vector>
+        Vector deserialize_pod_vector() {
+            uint32_t length = read_pod_blob_header<T>();
+            Vector values(length, allocator_for<Vector>());
+            std::memcpy(values.data(), data_ + position_, length * sizeof(T));
+            position_ += length * sizeof(T);
+            return values;
+        }
+
+        template<typename T, typename Vector>
+        Vector deserialize_list() {
+            uint32_t length = read_container_header(DataType::LIST);
+            Vector values(allocator_for<Vector>());
+            values.reserve(length);
+            for (uint32_t i = 0; i < length; ++i) {
+                values.push_back(deserialize_element<T>());
+            }
+            return values;
+        }
+
+        template<typename Map>
+        Map deserialize_map() {
+            uint32_t length = read_container_header(DataType::MAP);
+            Map values(allocator_for<Map>());
+            for (uint32_t i = 0; i < length; ++i) {
+                auto key = deserialize_element<typename Map::key_type>();
+                values.insert_or_assign(std::move(key), deserialize_element<typename Map::mapped_type>());
+            }
+            return values;
+        }
+
+        template<typename T>
+        void read_fixed_array(T* out, size_t count) {
+            if constexpr (is_wire_scalar_v<T>) {
+                validate_type(read_type(), get_array_data_type<T>());
+                uint32_t length = read_length();
+                if (length != count) {
+                    throw std::runtime_error("Array length mismatch during deserialization");
+                }
+                if constexpr (is_varint_v<T>) {
+                    if (format_ == WireFormat::COMPACT) {
+                        position_ += varint::decode_bulk(data_ + position_, size_ - position_, out, count);
+                        return;
+                    }
+                }
+                require(count * sizeof(T));
+                byte_order::from_wire(out, data_ + position_, count);
+                position_ += count * sizeof(T);
+            } else if constexpr (is_pod_element_v<T>) {
+                if (read_pod_blob_header<T>() != count) {
+                    throw std::runtime_error("Array length mismatch during deserialization");
+                }
+                std::memcpy(out, data_ + position_, count * sizeof(T));
+                position_ += count * sizeof(T);
+            } else {
+                if (read_container_header(DataType::LIST) != count) {
+                    throw std::runtime_error("Array length mismatch during deserialization");
+                }
+                for (size_t i = 0; i < count; ++i) {
+                    out[i] = deserialize_element<T>();
+                }
+            }
+        }
+
+        // 结构体内容由 Serializer<T>::serialize 写入，不区分线路格式，总是按定长格式读取
+        template<typename T>
+        T deserialize_struct() {
+            validate_type(read_type(), DataType::STRUCT);
+            struct FormatScope {
+                Deserializer& in;
+                WireFormat saved;
+                ~FormatScope() { in.format_ = saved; }
+            } scope{*this, format_};
+            format_ = WireFormat::FIXED;
+            return Serializer<T>::deserialize(*this);
+        }
+
         template<typename T>
         T deserialize_element() {
-            if constexpr (std::is_arithmetic_v<T> || std::is_same_v<T, std::string>) {
+            if constexpr (std::is_arithmetic_v<T> || is_std_string_v<T>) {
                 return deserialize_value<T>();
-            } else if constexpr (std::is_same_v<T, std::vector<typename T::value_type>>) {
-                return deserialize_vector<typename T::value_type>();
+            } else if constexpr (std::is_same_v<T, std::string_view>) {
+                return deserialize_string_view();
+            } else if constexpr (is_array_view_v<T>) {
+                return deserialize_vector_view<typename T::value_type>();
+            } else if constexpr (is_std_vector_v<T>) {
+                if constexpr (is_wire_scalar_v<typename T::value_type>) {
+                    return deserialize_vector<typename T::value_type, T>();
+                } else if constexpr (is_pod_element_v<typename T::value_type>) {
+                    return deserialize_pod_vector<typename T::value_type, T>();
+                } else {
+                    return deserialize_list<typename T::value_type, T>();
+                }
+            } else if constexpr (is_std_array_v<T>) {
+                T value{};
+                deserialize_into(value);
+                return value;
+            } else if constexpr (is_std_map_v<T>) {
+                return deserialize_map<T>();
+            } else if constexpr (has_struct_deserialize<T>::value) {
+                return deserialize_struct<T>();
             } else {
                 static_assert(!std::is_same_v<T, T>, "Unsupported element type for deserialization");
             }
         }
     };
     }
-}
\ No newline at end of file
+}
+
+#endif
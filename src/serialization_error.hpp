@@ -0,0 +1,26 @@
+#ifndef __RPC_SERIALIZATION_ERROR_H__
+#define __RPC_SERIALIZATION_ERROR_H__
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace rpc {
+namespace serialization {
+    // 缓冲区中的数据不完整。missing() 是继续解码至少还需要的字节数
+    // （变长字段只能知道下限），流式解码据此决定何时重试
+    class BufferUnderflow : public std::runtime_error {
+    public:
+        explicit BufferUnderflow(size_t missing)
+            : std::runtime_error("Buffer underflow: need " + std::to_string(missing) + " more bytes"),
+              missing_(missing) {}
+
+        size_t missing() const noexcept { return missing_; }
+
+    private:
+        size_t missing_;
+    };
+}
+}
+
+#endif
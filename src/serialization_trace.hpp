@@ -0,0 +1,93 @@
+#ifndef __RPC_SERIALIZATION_TRACE_H__
+#define __RPC_SERIALIZATION_TRACE_H__
+
+// 序列化跟踪钩子：记录每次序列化 / 反序列化的类型、字节数和耗时。
+// 默认关闭，关闭时所有跟踪宏展开为空，序列化路径上没有任何 I/O 和计时开销。
+// 调试时用 -DRPC_SERIALIZATION_TRACE=1 编译（CMake 选项 RPC_SERIALIZATION_TRACE）。
+#ifndef RPC_SERIALIZATION_TRACE
+#define RPC_SERIALIZATION_TRACE 0
+#endif
+
+#if RPC_SERIALIZATION_TRACE
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace rpc {
+namespace serialization {
+    enum class TraceEvent { SERIALIZE, DESERIALIZE };
+
+    struct TraceRecord {
+        TraceEvent event;
+        const char* type;       // 被处理的值的类型，如 "message"、"string"
+        size_t bytes;           // 负载字节数
+        int64_t nanoseconds;    // 耗时
+    };
+
+    using TraceHook = void (*)(const TraceRecord&);
+
+    // 默认钩子：输出到 stderr
+    inline void default_trace_hook(const TraceRecord& record) {
+        std::fprintf(stderr, "[serialization] %s %s: %zu bytes, %lld ns\n",
+                     record.event == TraceEvent::SERIALIZE ? "serialize" : "deserialize",
+                     record.type, record.bytes, static_cast<long long>(record.nanoseconds));
+    }
+
+    inline std::atomic<TraceHook>& trace_hook_slot() {
+        static std::atomic<TraceHook> hook{&default_trace_hook};
+        return hook;
+    }
+
+    // 替换跟踪钩子，返回之前的钩子；传入 nullptr 表示丢弃跟踪记录
+    inline TraceHook set_trace_hook(TraceHook hook) {
+        return trace_hook_slot().exchange(hook);
+    }
+
+    // 作用域结束时报告一条跟踪记录
+    class TraceScope {
+    public:
+        TraceScope(TraceEvent event, const char* type, size_t bytes)
+            : event_(event), type_(type), bytes_(bytes),
+              start_(std::chrono::steady_clock::now()) {}
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+        // 字节数要等编码完成才知道时（如紧凑编码）更新
+        void set_bytes(size_t bytes) { bytes_ = bytes; }
+
+        ~TraceScope() {
+            TraceHook hook = trace_hook_slot().load(std::memory_order_relaxed);
+            if (hook) {
+                auto elapsed = std::chrono::steady_clock::now() - start_;
+                hook(TraceRecord{event_, type_, bytes_,
+                     std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()});
+            }
+        }
+
+    private:
+        TraceEvent event_;
+        const char* type_;
+        size_t bytes_;
+        std::chrono::steady_clock::time_point start_;
+    };
+}
+}
+
+#define RPC_SERIALIZATION_TRACE_SCOPE(event, type, bytes) \
+    ::rpc::serialization::TraceScope rpc_trace_scope_(::rpc::serialization::TraceEvent::event, type, bytes)
+
+#define RPC_SERIALIZATION_TRACE_BYTES(bytes) rpc_trace_scope_.set_bytes(bytes)
+
+#else
+
+#define RPC_SERIALIZATION_TRACE_SCOPE(event, type, bytes) ((void)0)
+
+#define RPC_SERIALIZATION_TRACE_BYTES(bytes) ((void)0)
+
+#endif
+
+#endif
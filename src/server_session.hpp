@@ -0,0 +1,288 @@
+#ifndef __RPC_SERVER_SESSION_H__
+#define __RPC_SERVER_SESSION_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "completion_queue.hpp"
+#include "frame.hpp"
+#include "rpc_provider.hpp"
+#include "unix_socket.hpp"
+
+namespace rpc {
+namespace net {
+    // 一个连接上的协议状态：输入缓冲区中的完整请求帧交给 RpcProvider 处理，
+    // 响应帧追加到输出缓冲区。不涉及任何 I/O，epoll 等不同的 I/O 后端共用。
+    // 默认同步处理，请求按顺序应答；enable_async() 之后线程池中的函数不阻塞连接，
+    // 完成时响应经 CompletionQueue 交回事件循环，再由 complete() 追加，响应可能乱序
+    class ServerSession {
+    public:
+        ServerSession(RpcProvider& provider, size_t max_frame_bytes)
+            : provider_(provider), max_frame_bytes_(max_frame_bytes) {}
+
+        ServerSession(ServerSession&& other) noexcept
+            : provider_(other.provider_), max_frame_bytes_(other.max_frame_bytes_),
+              input_(std::move(other.input_)), input_begin_(other.input_begin_), input_end_(other.input_end_),
+              needed_(other.needed_), output_(std::move(other.output_)), output_sent_(other.output_sent_),
+              descriptors_(std::exchange(other.descriptors_, {})), completions_(std::move(other.completions_)),
+              connection_(other.connection_), max_in_flight_(other.max_in_flight_), in_flight_(other.in_flight_),
+              max_pending_output_(other.max_pending_output_) {}
+
+        ServerSession& operator=(ServerSession&&) = delete;
+
+        ~ServerSession() {
+            for (int fd : descriptors_) {
+                close(fd);
+            }
+        }
+
+        // 输入缓冲区末尾的可写空间，至少 min_space 字节；
+        // 已知当前帧的长度时一次预留整个帧，大请求不会被切成很多次 read
+        span<uint8_t> read_space(size_t min_space = 4096) {
+            size_t want = std::max(min_space, needed_);
+            if (input_.size() - input_end_ < want) {
+                compact_input();
+                if (input_.size() - input_end_ < want) {
+                    input_.resize(input_end_ + want);
+                }
+            }
+            return span<uint8_t>(input_.data() + input_end_, input_.size() - input_end_);
+        }
+
+        // 数据已经读入 read_space() 返回的空间
+        void commit_read(size_t bytes) { input_end_ += bytes; }
+
+        // 复制外部缓冲区中的数据（I/O 后端自己管理接收缓冲区时使用）
+        void append_input(ByteSpan data) {
+            span<uint8_t> space = read_space(data.size());
+            std::memcpy(space.data(), data.data(), data.size());
+            commit_read(data.size());
+        }
+
+        // 线程池中的调用完成后把响应帧（连同 connection）推入 completions；
+        // 同一连接最多 max_in_flight 个未完成的调用，超过时暂停处理后续请求帧
+        void enable_async(std::shared_ptr<CompletionQueue> completions, uint64_t connection, size_t max_in_flight) {
+            completions_ = std::move(completions);
+            connection_ = connection;
+            max_in_flight_ = std::max<size_t>(1, max_in_flight);
+        }
+
+        // 未发送的响应超过 bytes 字节时暂停，对端只发请求不读响应时输出缓冲区不会无限增长
+        void limit_output(size_t bytes) { max_pending_output_ = bytes; }
+
+        // 追加一个异步完成的响应帧
+        void complete(ByteSpan frame) {
+            output_.insert(output_.end(), frame.begin(), frame.end());
+            --in_flight_;
+        }
+
+        // 已提交到线程池、尚未应答的请求数
+        size_t in_flight() const { return in_flight_; }
+
+        // 未完成的调用达到上限或积压的响应过多，process() 不再处理新的请求帧。
+        // 此时 I/O 后端应停止读取，让后续数据留在内核中由 TCP 流量控制限制对端，
+        // complete() 或响应发出之后再恢复
+        bool paused() const {
+            return (completions_ && in_flight_ >= max_in_flight_) || output_.size() - output_sent_ > max_pending_output_;
+        }
+
+        // 随数据一起收到的文件描述符（Unix 域套接字的 SCM_RIGHTS），按到达顺序
+        // 属于带 frame_descriptor_flag 的请求帧。会话负责关闭。积压过多时返回 false
+        bool push_descriptor(int fd) {
+            descriptors_.push_back(fd);
+            return descriptors_.size() <= max_pending_descriptors;
+        }
+
+        // 处理输入缓冲区中所有完整的请求帧。帧长度超过上限或描述符帧无效时返回 false，调用方应关闭连接
+        bool process() {
+            while (!paused()) {
+                ByteSpan input(input_.data() + input_begin_, input_end_ - input_begin_);
+                if (input.size() >= frame_header_size) {
+                    uint32_t length = frame_payload_length(input.data());
+                    if (length & frame_descriptor_flag) {
+                        if (!dispatch_descriptor(frame_request_id(input.data()), length & ~frame_descriptor_flag)) {
+                            return false;
+                        }
+                        input_begin_ += frame_header_size;
+                        continue;
+                    }
+                    if (length > max_frame_bytes_) {
+                        return false;
+                    }
+                }
+                auto payload = next_frame(input, needed_);
+                if (!payload) {
+                    break;
+                }
+                dispatch(frame_request_id(input.data()), *payload);
+                input_begin_ += frame_header_size + payload->size();
+            }
+            if (input_begin_ == input_end_) {
+                input_begin_ = input_end_ = 0;
+            }
+            return true;
+        }
+
+        // 尚未发送的响应数据
+        ByteSpan pending_output() const {
+            return ByteSpan(output_.data() + output_sent_, output_.size() - output_sent_);
+        }
+
+        bool has_output() const { return output_sent_ < output_.size(); }
+
+        // 前 bytes 字节已发送
+        void consume_output(size_t bytes) {
+            output_sent_ += bytes;
+            if (output_sent_ == output_.size()) {
+                output_.clear();
+                output_sent_ = 0;
+            } else if (output_sent_ * 2 > output_.size()) {
+                output_.erase(output_.begin(), output_.begin() + output_sent_);
+                output_sent_ = 0;
+            }
+        }
+
+        // 取走所有未发送的响应（异步发送期间缓冲区必须保持不变的 I/O 后端使用），
+        // 没有部分发送时直接交换内存，两个缓冲区轮流使用
+        void take_output(std::vector<uint8_t>& out) {
+            out.clear();
+            if (output_sent_ == 0) {
+                out.swap(output_);
+            } else {
+                out.assign(output_.begin() + output_sent_, output_.end());
+                output_.clear();
+                output_sent_ = 0;
+            }
+        }
+
+    private:
+        static constexpr size_t max_pending_descriptors = 64;
+
+        RpcProvider& provider_;
+        size_t max_frame_bytes_;
+        std::vector<uint8_t> input_;
+        size_t input_begin_ = 0;
+        size_t input_end_ = 0;
+        // 当前不完整的帧至少还需要的字节数
+        size_t needed_ = 0;
+        std::vector<uint8_t> output_;
+        size_t output_sent_ = 0;
+        std::deque<int> descriptors_;
+        std::shared_ptr<CompletionQueue> completions_;
+        uint64_t connection_ = 0;
+        size_t max_in_flight_ = 1;
+        size_t in_flight_ = 0;
+        size_t max_pending_output_ = std::numeric_limits<size_t>::max();
+
+        void compact_input() {
+            if (input_begin_ > 0) {
+                std::memmove(input_.data(), input_.data() + input_begin_, input_end_ - input_begin_);
+                input_end_ -= input_begin_;
+                input_begin_ = 0;
+            }
+        }
+
+        // 处理一个请求。同步完成的响应直接编码进输出缓冲区；
+        // 提交到线程池的调用在完成时由工作线程编码整个响应帧
+        void dispatch(uint32_t request_id, ByteSpan payload) {
+            size_t start = begin_frame(output_, request_id);
+            output_.push_back(static_cast<uint8_t>(FrameStatus::OK));
+            try {
+                FunctionId id;
+                ByteSpan args;
+                if (!parse_method(payload, id, args)) {
+                    throw RpcException(RpcException::ErrorType::ARGUMENT_ERROR,
+                                       "Request must start with a function id or name");
+                }
+                if (!completions_) {
+                    provider_.call_function_binary(id, args, output_);
+                } else if (!provider_.call_function_binary_async(id, args, output_, completion(request_id))) {
+                    output_.resize(start);
+                    ++in_flight_;
+                    return;
+                }
+            } catch (...) {
+                output_.resize(start + frame_header_size);
+                encode_failure(output_, std::current_exception());
+            }
+            end_frame(output_, start);
+        }
+
+        RpcProvider::BinaryCompletion completion(uint32_t request_id) {
+            return [completions = completions_, connection = connection_, request_id](
+                       std::vector<uint8_t> result, std::exception_ptr error) {
+                std::vector<uint8_t> frame;
+                frame.reserve(frame_header_size + 1 + result.size());
+                size_t start = begin_frame(frame, request_id);
+                if (error) {
+                    encode_failure(frame, error);
+                } else {
+                    frame.push_back(static_cast<uint8_t>(FrameStatus::OK));
+                    frame.insert(frame.end(), result.begin(), result.end());
+                }
+                end_frame(frame, start);
+                completions->push(connection, std::move(frame));
+            };
+        }
+
+        // 错误响应：RpcException 映射为对应的状态，其他异常为 HANDLER_ERROR
+        static void encode_failure(std::vector<uint8_t>& out, std::exception_ptr error) {
+            try {
+                std::rethrow_exception(error);
+            } catch (const RpcException& e) {
+                encode_error(out, static_cast<FrameStatus>(static_cast<uint8_t>(e.type()) + 1), e.what());
+            } catch (const std::exception& e) {
+                encode_error(out, FrameStatus::HANDLER_ERROR, e.what());
+            } catch (...) {
+                encode_error(out, FrameStatus::HANDLER_ERROR, "Unknown exception");
+            }
+        }
+
+        // 负载在下一个收到的 memfd 中：检查封印后只读映射，直接在映射上处理
+        bool dispatch_descriptor(uint32_t request_id, size_t length) {
+            if (descriptors_.empty() || length > max_frame_bytes_) {
+                return false;
+            }
+            MappedPayload payload;
+            bool mapped = payload.map(descriptors_.front(), length);
+            descriptors_.pop_front();
+            if (!mapped) {
+                return false;
+            }
+            dispatch(request_id, payload.bytes());
+            return true;
+        }
+
+        bool parse_method(ByteSpan payload, FunctionId& id, ByteSpan& args) {
+            if (payload.empty()) {
+                return false;
+            }
+            serialization::Deserializer in(payload, serialization::WireFormat::FIXED);
+            try {
+                auto type = static_cast<serialization::DataType>(payload[0]);
+                if (type == serialization::DataType::UINT32) {
+                    id = in.deserialize<uint32_t>();
+                } else if (type == serialization::DataType::STRING) {
+                    id = provider_.function_id(std::string(in.deserialize<std::string_view>()));
+                } else {
+                    return false;
+                }
+            } catch (const serialization::BufferUnderflow&) {
+                return false;
+            }
+            args = payload.subspan(in.position());
+            return true;
+        }
+    };
+}
+}
+
+#endif
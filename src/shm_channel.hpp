@@ -0,0 +1,401 @@
+#ifndef __RPC_SHM_CHANNEL_H__
+#define __RPC_SHM_CHANNEL_H__
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include "span.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace rpc {
+    // 共享内存传输的配置，服务端和客户端各自设置
+    struct ShmOptions {
+        size_t ring_bytes = 1 << 20;                // 每个方向的环形缓冲区大小（向上取整为 2 的幂）
+        unsigned spin_iterations = 256;             // 睡眠前自旋检查的次数
+        bool busy_poll = false;                     // 永不睡眠，一直轮询（占满一个 CPU 核，延迟最低）
+        size_t max_frame_bytes = 64 * 1024 * 1024;  // 服务端：超过此长度的请求帧直接关闭通道
+    };
+
+namespace net {
+    inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+
+    // 放在共享内存中的等待点：消费方在条件不满足时睡在 futex 上，生产方只在有人睡眠时才进入内核。
+    // futex 不带 FUTEX_PRIVATE_FLAG，不同进程映射同一块内存也能互相唤醒
+    struct ShmWaiter {
+        std::atomic<uint32_t> sequence{0};
+        std::atomic<uint32_t> sleepers{0};
+
+        // 等待 ready() 为真。先自旋 spin_iterations 次（只有一个 CPU 时对端不可能同时运行，不自旋）；
+        // busy_poll 时不睡眠，只定期让出 CPU
+        template<typename Ready>
+        void wait(Ready ready, const ShmOptions& options) {
+            static const bool multi_core = std::thread::hardware_concurrency() > 1;
+            unsigned spins = multi_core ? options.spin_iterations : 0;
+            for (unsigned i = 0; i < spins || options.busy_poll; ++i) {
+                if (ready()) {
+                    return;
+                }
+                cpu_relax();
+                if (options.busy_poll && (i & 63) == 63) {
+                    std::this_thread::yield();
+                }
+            }
+            while (true) {
+                uint32_t observed = sequence.load(std::memory_order_acquire);
+                sleepers.fetch_add(1, std::memory_order_seq_cst);
+                if (ready()) {
+                    sleepers.fetch_sub(1, std::memory_order_relaxed);
+                    return;
+                }
+                syscall(SYS_futex, reinterpret_cast<uint32_t*>(&sequence), FUTEX_WAIT, observed,
+                        nullptr, nullptr, 0);
+                sleepers.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        // 条件的修改（release 写）之后调用。用读-改-写读取 sleepers：与等待方的 fetch_add 全序，
+        // 要么这里看到等待方，要么等待方的 ready() 看到修改
+        void notify() {
+            if (sleepers.fetch_add(0, std::memory_order_seq_cst) != 0) {
+                wake();
+            }
+        }
+
+        void wake() {
+            sequence.fetch_add(1, std::memory_order_release);
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&sequence), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+        }
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+                  "Shared-memory rings need address-free atomics");
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32 bits");
+
+    // 单生产者单消费者的字节环，头部与数据都在共享内存中。
+    // 传输的是与 TCP 相同的帧字节流，帧可以跨越环尾，也可以比环更大（分多次写入）
+    struct ShmRingHeader {
+        alignas(64) std::atomic<uint64_t> head{0};  // 消费方已读到的位置
+        alignas(64) std::atomic<uint64_t> tail{0};  // 生产方已写到的位置
+        alignas(64) ShmWaiter readable;
+        alignas(64) ShmWaiter writable;
+    };
+
+    static_assert(sizeof(ShmRingHeader) <= 4096, "Ring header must fit in one page");
+
+    // 通道的共享内存布局：控制块、请求环、响应环
+    struct ShmControl {
+        static constexpr uint64_t magic_value = 0x31474e4952435052ull;  // "RPCRING1"
+
+        uint64_t magic;
+        uint64_t ring_bytes;
+        alignas(64) std::atomic<uint32_t> closed{0};
+    };
+
+    // 一个方向的环在本进程中的视图。head/tail 的对端值缓存在本地，减少缓存行来回传递。
+    // head/tail 位于与对端共享的内存中，对端可能写入任意值：已用字节数不在 [0, capacity] 内时按通道关闭处理
+    class ShmRing {
+    public:
+        ShmRing() = default;
+        ShmRing(ShmRingHeader* header, uint8_t* data, size_t capacity, std::atomic<uint32_t>* closed)
+            : header_(header), data_(data), mask_(capacity - 1), closed_(closed) {}
+
+        // 生产方：尽量写入，返回实际写入的字节数（环满或通道关闭时为 0）
+        size_t write_some(ByteSpan bytes) {
+            uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+            if (tail - cached_head_ > capacity() || capacity() - (tail - cached_head_) < bytes.size()) {
+                cached_head_ = header_->head.load(std::memory_order_acquire);
+                if (tail - cached_head_ > capacity()) {
+                    abandon();
+                    return 0;
+                }
+            }
+            size_t count = std::min<size_t>(bytes.size(), capacity() - (tail - cached_head_));
+            if (count == 0) {
+                return 0;
+            }
+            size_t offset = tail & mask_;
+            size_t first = std::min(count, capacity() - offset);
+            std::memcpy(data_ + offset, bytes.data(), first);
+            std::memcpy(data_, bytes.data() + first, count - first);
+            header_->tail.store(tail + count, std::memory_order_release);
+            header_->readable.notify();
+            return count;
+        }
+
+        // 生产方：写入全部数据，环满时等待。通道关闭时返回 false
+        bool write_all(ByteSpan bytes, const ShmOptions& options) {
+            while (!bytes.empty()) {
+                size_t count = write_some(bytes);
+                bytes = bytes.subspan(count);
+                if (count == 0) {
+                    header_->writable.wait([&] { return writable() || closed(); }, options);
+                    if (closed()) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // 消费方：环中从读位置开始的连续可读数据（不跨越环尾）
+        ByteSpan readable() {
+            uint64_t head = header_->head.load(std::memory_order_relaxed);
+            if (cached_tail_ == head) {
+                cached_tail_ = header_->tail.load(std::memory_order_acquire);
+            }
+            if (cached_tail_ - head > capacity()) {
+                abandon();
+                return ByteSpan();
+            }
+            size_t offset = head & mask_;
+            size_t count = std::min<size_t>(cached_tail_ - head, capacity() - offset);
+            return ByteSpan(data_ + offset, count);
+        }
+
+        // 消费方：前 bytes 字节已读
+        void consume(size_t bytes) {
+            header_->head.store(header_->head.load(std::memory_order_relaxed) + bytes, std::memory_order_release);
+            header_->writable.notify();
+        }
+
+        // 消费方：读满 size 字节，没有数据时等待。通道关闭时返回 false
+        bool read_exact(uint8_t* out, size_t size, const ShmOptions& options) {
+            while (size > 0) {
+                if (!wait_readable(options)) {
+                    return false;
+                }
+                ByteSpan available = readable();
+                size_t count = std::min(size, available.size());
+                std::memcpy(out, available.data(), count);
+                consume(count);
+                out += count;
+                size -= count;
+            }
+            return true;
+        }
+
+        // 消费方：等待有数据可读。通道关闭且没有剩余数据时返回 false
+        bool wait_readable(const ShmOptions& options) {
+            if (!readable().empty()) {
+                return true;
+            }
+            header_->readable.wait([&] { return !readable().empty() || closed(); }, options);
+            return !readable().empty();
+        }
+
+        size_t capacity() const { return mask_ + 1; }
+
+        bool closed() const { return closed_->load(std::memory_order_acquire) != 0; }
+
+        // 关闭时唤醒两端所有等待者
+        void wake_all() {
+            header_->readable.wake();
+            header_->writable.wake();
+        }
+
+    private:
+        ShmRingHeader* header_ = nullptr;
+        uint8_t* data_ = nullptr;
+        size_t mask_ = 0;
+        std::atomic<uint32_t>* closed_ = nullptr;
+        uint64_t cached_head_ = 0;
+        uint64_t cached_tail_ = 0;
+
+        bool writable() {
+            cached_head_ = header_->head.load(std::memory_order_acquire);
+            return header_->tail.load(std::memory_order_relaxed) - cached_head_ < capacity();
+        }
+
+        // 读写位置被破坏：关闭通道并唤醒两端，之后不再访问环中的数据
+        void abandon() {
+            closed_->store(1, std::memory_order_release);
+            wake_all();
+        }
+    };
+
+    // 同机调用方与服务端之间的一条通道：一块 memfd 或 POSIX 共享内存，
+    // 其中有一个请求环（客户端写、服务端读）和一个响应环（服务端写、客户端读）。
+    // 两个方向都是单生产者单消费者；多个调用方各自使用自己的通道
+    class ShmChannel {
+    public:
+        ShmChannel() = default;
+
+        // 创建新通道。name 为空时使用匿名 memfd（通过 fd() 继承或传递给对端），
+        // 否则创建 POSIX 共享内存对象 name（如 "/my_service"），对端用 open() 打开
+        static ShmChannel create(size_t ring_bytes, const std::string& name = "") {
+            size_t capacity = 4096;
+            while (capacity < ring_bytes) {
+                capacity <<= 1;
+            }
+            int fd = name.empty() ? memfd_create("rpc_shm_channel", MFD_CLOEXEC)
+                                  : shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+            if (fd < 0) {
+                throw std::system_error(errno, std::generic_category(), name.empty() ? "memfd_create" : "shm_open");
+            }
+            ShmChannel channel;
+            channel.fd_ = fd;
+            channel.name_ = name;
+            channel.size_ = layout_size(capacity);
+            if (ftruncate(fd, static_cast<off_t>(channel.size_)) < 0) {
+                int error = errno;
+                channel.unlink();
+                throw std::system_error(error, std::generic_category(), "ftruncate");
+            }
+            channel.map();
+            new (channel.base_) ShmControl{ShmControl::magic_value, capacity};
+            new (channel.base_ + request_offset()) ShmRingHeader();
+            new (channel.base_ + response_offset(capacity)) ShmRingHeader();
+            channel.attach_rings();
+            return channel;
+        }
+
+        // 打开 create() 创建的具名通道
+        static ShmChannel open(const std::string& name) {
+            int fd = shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0);
+            if (fd < 0) {
+                throw std::system_error(errno, std::generic_category(), "shm_open");
+            }
+            return from_fd(fd);
+        }
+
+        // 映射对端传来的通道描述符（取得 fd 的所有权）
+        static ShmChannel from_fd(int fd) {
+            ShmChannel channel;
+            channel.fd_ = fd;
+            struct stat st;
+            if (fstat(fd, &st) < 0) {
+                throw std::system_error(errno, std::generic_category(), "fstat");
+            }
+            channel.size_ = static_cast<size_t>(st.st_size);
+            if (channel.size_ < sizeof(ShmControl)) {
+                throw std::system_error(EINVAL, std::generic_category(), "Not an RPC shared-memory channel");
+            }
+            channel.map();
+            const ShmControl* control = channel.control();
+            if (control->magic != ShmControl::magic_value || control->ring_bytes < 4096 ||
+                (control->ring_bytes & (control->ring_bytes - 1)) != 0 ||
+                layout_size(control->ring_bytes) != channel.size_) {
+                throw std::system_error(EINVAL, std::generic_category(), "Not an RPC shared-memory channel");
+            }
+            channel.attach_rings();
+            return channel;
+        }
+
+        ShmChannel(ShmChannel&& other) noexcept { *this = std::move(other); }
+
+        ShmChannel& operator=(ShmChannel&& other) noexcept {
+            if (this != &other) {
+                release();
+                fd_ = std::exchange(other.fd_, -1);
+                base_ = std::exchange(other.base_, nullptr);
+                size_ = std::exchange(other.size_, 0);
+                name_ = std::move(other.name_);
+                other.name_.clear();
+                request_ = other.request_;
+                response_ = other.response_;
+            }
+            return *this;
+        }
+
+        ~ShmChannel() { release(); }
+
+        // 客户端写、服务端读
+        ShmRing& requests() { return request_; }
+        // 服务端写、客户端读
+        ShmRing& responses() { return response_; }
+
+        int fd() const { return fd_; }
+        bool valid() const { return base_ != nullptr; }
+
+        // 通知两端不再通信，唤醒所有等待者
+        void close() {
+            if (!base_) {
+                return;
+            }
+            control()->closed.store(1, std::memory_order_release);
+            request_.wake_all();
+            response_.wake_all();
+        }
+
+        bool closed() const { return !base_ || request_.closed(); }
+
+        // 删除具名通道的名字，已经映射的两端不受影响。创建者析构时自动删除
+        void unlink() {
+            if (!name_.empty()) {
+                shm_unlink(name_.c_str());
+                name_.clear();
+            }
+        }
+
+    private:
+        int fd_ = -1;
+        uint8_t* base_ = nullptr;
+        size_t size_ = 0;
+        std::string name_;
+        ShmRing request_;
+        ShmRing response_;
+
+        static constexpr size_t request_offset() { return 4096; }
+        static size_t response_offset(size_t capacity) { return request_offset() + 4096 + capacity; }
+        static size_t layout_size(size_t capacity) { return response_offset(capacity) + 4096 + capacity; }
+
+        ShmControl* control() const { return reinterpret_cast<ShmControl*>(base_); }
+
+        void map() {
+            void* base = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+            if (base == MAP_FAILED) {
+                throw std::system_error(errno, std::generic_category(), "mmap");
+            }
+            base_ = static_cast<uint8_t*>(base);
+        }
+
+        void attach_rings() {
+            size_t capacity = control()->ring_bytes;
+            uint8_t* request = base_ + request_offset();
+            uint8_t* response = base_ + response_offset(capacity);
+            request_ = ShmRing(reinterpret_cast<ShmRingHeader*>(request), request + 4096, capacity, &control()->closed);
+            response_ = ShmRing(reinterpret_cast<ShmRingHeader*>(response), response + 4096, capacity,
+                                &control()->closed);
+        }
+
+        void release() {
+            unlink();
+            if (base_) {
+                munmap(base_, size_);
+                base_ = nullptr;
+            }
+            if (fd_ >= 0) {
+                ::close(fd_);
+                fd_ = -1;
+            }
+        }
+    };
+}
+}
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef __RPC_SHM_CLIENT_H__
+#define __RPC_SHM_CLIENT_H__
+
+#include <cerrno>
+#include <string>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+#include "frame.hpp"
+#include "rpc_client.hpp"
+#include "shm_channel.hpp"
+
+namespace rpc {
+    // 共享内存客户端：call() / invoke() 与 RpcClient 相同，一次发送一个请求并等待响应。
+    // 不是线程安全的，每个调用线程使用自己的通道
+    class ShmClient {
+    public:
+        explicit ShmClient(net::ShmChannel channel, ShmOptions options = ShmOptions())
+            : channel_(std::move(channel)), options_(std::move(options)) {}
+
+        // 打开 ShmServer::open_channel(name) 创建的具名通道
+        explicit ShmClient(const std::string& name, ShmOptions options = ShmOptions())
+            : ShmClient(net::ShmChannel::open(name), std::move(options)) {}
+
+        ShmClient(const ShmClient&) = delete;
+        ShmClient& operator=(const ShmClient&) = delete;
+
+        // 关闭通道，服务端的服务线程随之退出
+        ~ShmClient() { channel_.close(); }
+
+        // 参数与返回值的编码同 RpcProvider::call_function_binary；
+        // 错误响应抛出 RpcException（处理函数抛出的其他异常为 std::runtime_error）
+        std::vector<uint8_t> call(FunctionId id, ByteSpan args) {
+            send_buffer_.clear();
+            net::encode_request(send_buffer_, id, args, ++next_request_id_);
+            return round_trip();
+        }
+
+        std::vector<uint8_t> call(const std::string& method, ByteSpan args) {
+            send_buffer_.clear();
+            net::encode_request(send_buffer_, method, args, ++next_request_id_);
+            return round_trip();
+        }
+
+        // 按函数编号或函数名调用，参数和返回值按 serialization 格式编解码
+        template<typename Ret, typename Method, typename... Args>
+        Ret invoke(const Method& method, const Args&... args) {
+            static_assert(!serialization::is_borrowed_v<Ret>, "Return values must own their data");
+            std::vector<uint8_t> encoded;
+            serialization::serialize_into(encoded, args...);
+            auto reply = call(method, encoded);
+            if constexpr (!std::is_void_v<Ret>) {
+                return serialization::Deserializer(reply).deserialize<Ret>();
+            }
+        }
+
+    private:
+        net::ShmChannel channel_;
+        ShmOptions options_;
+        uint32_t next_request_id_ = 0;
+        std::vector<uint8_t> send_buffer_;
+
+        std::vector<uint8_t> round_trip() {
+            net::ShmRing& responses = channel_.responses();
+            uint8_t header[net::frame_header_size];
+            if (!channel_.requests().write_all(send_buffer_, options_) ||
+                !responses.read_exact(header, sizeof(header), options_)) {
+                throw std::system_error(ECONNRESET, std::generic_category(), "Shared-memory channel closed");
+            }
+            std::vector<uint8_t> payload(net::frame_payload_length(header));
+            if (!responses.read_exact(payload.data(), payload.size(), options_)) {
+                throw std::system_error(ECONNRESET, std::generic_category(), "Shared-memory channel closed");
+            }
+            if (net::frame_request_id(header) != next_request_id_) {
+                throw std::runtime_error("Response does not match the outstanding request");
+            }
+            return net::decode_response(std::move(payload));
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef __RPC_SHM_SERVER_H__
+#define __RPC_SHM_SERVER_H__
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "rpc_provider.hpp"
+#include "server_session.hpp"
+#include "shm_channel.hpp"
+
+namespace rpc {
+    // 同机调用方的共享内存前端：每个通道一个服务线程，请求帧与 TCP 前端格式相同，
+    // 同样交给 RpcProvider::call_function_binary 处理，完全绕过网络协议栈。
+    // 通道上的请求在服务线程上按顺序同步处理（ShmClient 一次只有一个未完成的请求）。
+    // 客户端关闭通道后服务线程退出，通道在下一次 serve() 或 channel_count() 时回收。
+    // 所有函数必须在创建通道之前注册
+    class ShmServer {
+    public:
+        explicit ShmServer(RpcProvider& provider, ShmOptions options = ShmOptions())
+            : provider_(provider), options_(std::move(options)) {}
+
+        ShmServer(const ShmServer&) = delete;
+        ShmServer& operator=(const ShmServer&) = delete;
+
+        ~ShmServer() { stop(); }
+
+        // 创建通道并开始服务，返回通道的描述符（仍归服务器所有，通道回收后失效）。
+        // name 为空时为匿名 memfd，由调用方复制后通过 fork 继承或 SCM_RIGHTS 交给客户端；
+        // 否则客户端用 ShmClient(name) 打开，服务器停止时删除该名字
+        int open_channel(const std::string& name = "") {
+            return serve(net::ShmChannel::create(options_.ring_bytes, name));
+        }
+
+        // 服务一个已经建立的通道（例如客户端创建后传过来的）
+        int serve(net::ShmChannel channel) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            reap_finished();
+            auto worker = std::make_unique<Worker>();
+            worker->channel = std::move(channel);
+            worker->thread = std::thread([this, worker = worker.get()]() { run(*worker); });
+            workers_.push_back(std::move(worker));
+            return workers_.back()->channel.fd();
+        }
+
+        // 关闭所有通道并等待服务线程退出
+        void stop() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& worker : workers_) {
+                worker->channel.close();
+            }
+            for (auto& worker : workers_) {
+                worker->thread.join();
+            }
+            workers_.clear();
+        }
+
+        // 仍在服务的通道数，同时回收已经关闭的通道
+        size_t channel_count() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            reap_finished();
+            return workers_.size();
+        }
+
+    private:
+        struct Worker {
+            net::ShmChannel channel;
+            std::thread thread;
+            std::atomic<bool> done{false};
+        };
+
+        RpcProvider& provider_;
+        ShmOptions options_;
+        std::mutex mutex_;
+        std::vector<std::unique_ptr<Worker>> workers_;
+
+        // 读出请求环中的数据交给会话，完整的请求帧处理后把响应写入响应环。
+        // 客户端关闭通道或请求帧超长时退出
+        void run(Worker& worker) {
+            net::ShmChannel& channel = worker.channel;
+            net::ServerSession session(provider_, options_.max_frame_bytes);
+            net::ShmRing& requests = channel.requests();
+            net::ShmRing& responses = channel.responses();
+            while (requests.wait_readable(options_)) {
+                ByteSpan input = requests.readable();
+                session.append_input(input);
+                requests.consume(input.size());
+                if (!session.process()) {
+                    break;
+                }
+                ByteSpan output = session.pending_output();
+                if (!output.empty()) {
+                    if (!responses.write_all(output, options_)) {
+                        break;
+                    }
+                    session.consume_output(output.size());
+                }
+            }
+            channel.close();
+            worker.done.store(true, std::memory_order_release);
+        }
+
+        // 释放服务线程已经退出的通道：回收线程、映射和描述符。调用方持有 mutex_
+        void reap_finished() {
+            auto finished = std::stable_partition(workers_.begin(), workers_.end(), [](const auto& worker) {
+                return !worker->done.load(std::memory_order_acquire);
+            });
+            for (auto it = finished; it != workers_.end(); ++it) {
+                (*it)->thread.join();
+            }
+            workers_.erase(finished, workers_.end());
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef __RPC_SPAN_H__
+#define __RPC_SPAN_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace rpc {
+    // C++17 下 std::span 的最小替代：指向连续内存的非拥有视图
+    template<typename T>
+    class span {
+    public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+        using iterator = T*;
+
+        constexpr span() noexcept = default;
+        constexpr span(T* data, size_t size) noexcept : data_(data), size_(size) {}
+
+        template<size_t N>
+        constexpr span(T (&array)[N]) noexcept : data_(array), size_(N) {}
+
+        // 从 std::vector / std::array / std::string 等连续容器构造；
+        // 只读视图也可以绑定到临时容器（与 std::span<const T> 一致，调用方负责生命周期）
+        template<typename Container,
+                 typename = std::enable_if_t<
+                     !std::is_same_v<std::decay_t<Container>, span> &&
+                     std::is_convertible_v<decltype(std::declval<Container&>().data()), T*> &&
+                     (std::is_lvalue_reference_v<Container> || std::is_const_v<T>)>>
+        constexpr span(Container&& container) noexcept
+            : data_(container.data()), size_(container.size()) {}
+
+        constexpr T* data() const noexcept { return data_; }
+        constexpr size_t size() const noexcept { return size_; }
+        constexpr size_t size_bytes() const noexcept { return size_ * sizeof(T); }
+        constexpr bool empty() const noexcept { return size_ == 0; }
+
+        constexpr T* begin() const noexcept { return data_; }
+        constexpr T* end() const noexcept { return data_ + size_; }
+
+        constexpr T& operator[](size_t index) const { return data_[index]; }
+
+        constexpr span subspan(size_t offset, size_t count) const {
+            return span(data_ + offset, count);
+        }
+
+        constexpr span subspan(size_t offset) const {
+            return span(data_ + offset, size_ - offset);
+        }
+
+    private:
+        T* data_ = nullptr;
+        size_t size_ = 0;
+    };
+
+    using ByteSpan = span<const uint8_t>;
+}
+
+#endif
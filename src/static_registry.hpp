@@ -0,0 +1,272 @@
+#ifndef __RPC_STATIC_REGISTRY_H__
+#define __RPC_STATIC_REGISTRY_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "rpc_provider.hpp"
+#include "param_index.hpp"
+
+namespace rpc {
+    namespace detail {
+        // 函数指针的签名信息
+        template<typename F>
+        struct function_traits;
+
+        template<typename R, typename... A>
+        struct function_traits<R(*)(A...)> {
+            using return_type = R;
+            using args_tuple = std::tuple<A...>;
+            static constexpr size_t arity = sizeof...(A);
+        };
+
+        constexpr bool is_param_name_space(char c) {
+            return c == ' ' || c == '\t' || c == '\n';
+        }
+
+        // 编译期统计 "a, b, c" 形式的参数名列表中的名字个数（空列表为 0），
+        // 用于检查列出的名字个数与函数的参数个数一致
+        constexpr size_t count_param_names(std::string_view list) {
+            size_t count = 0;
+            bool blank = true;
+            for (char c : list) {
+                if (c == ',') {
+                    ++count;
+                } else if (!is_param_name_space(c)) {
+                    blank = false;
+                }
+            }
+            return blank && count == 0 ? 0 : count + 1;
+        }
+
+        // 编译期拆分 "a, b, c" 形式的参数名列表
+        template<size_t N>
+        constexpr std::array<std::string_view, N> split_param_names(std::string_view list) {
+            std::array<std::string_view, N> names{};
+            size_t count = 0;
+            size_t pos = 0;
+            while (pos <= list.size() && count < N) {
+                size_t end = list.find(',', pos);
+                if (end == std::string_view::npos) {
+                    end = list.size();
+                }
+                std::string_view token = list.substr(pos, end - pos);
+                while (!token.empty() && is_param_name_space(token.front())) {
+                    token.remove_prefix(1);
+                }
+                while (!token.empty() && is_param_name_space(token.back())) {
+                    token.remove_suffix(1);
+                }
+                names[count++] = token;
+                pos = end + 1;
+            }
+            return names;
+        }
+
+        // 在编译期为一组名字搜索完美哈希的 seed 和槽位表
+        template<size_t N>
+        struct PerfectHash {
+            static constexpr size_t table_size = next_power_of_two(N * 2 == 0 ? 1 : N * 2);
+
+            uint32_t seed = 0;
+            // 槽位中存放 方法下标 + 1，0 表示空槽
+            std::array<uint16_t, table_size> slots{};
+            bool found = false;
+
+            constexpr size_t slot_of(std::string_view name) const {
+                return fnv1a(name, seed) & (table_size - 1);
+            }
+
+            static constexpr PerfectHash build(const std::array<std::string_view, N>& names) {
+                PerfectHash result;
+                for (uint32_t seed = 0; seed < 100000; ++seed) {
+                    PerfectHash candidate;
+                    candidate.seed = seed;
+                    bool collision = false;
+                    for (size_t i = 0; i < N && !collision; ++i) {
+                        size_t slot = candidate.slot_of(names[i]);
+                        if (candidate.slots[slot] != 0) {
+                            collision = true;
+                        } else {
+                            candidate.slots[slot] = static_cast<uint16_t>(i + 1);
+                        }
+                    }
+                    if (!collision) {
+                        candidate.found = true;
+                        return candidate;
+                    }
+                }
+                return result;
+            }
+        };
+    }
+
+    // 静态服务：方法集合在编译期确定，通过完美哈希查找，
+    // 经由函数指针表直接调用处理函数，不经过 std::function / std::any
+    template<typename... Methods>
+    class StaticRegistry {
+    public:
+        static constexpr size_t size = sizeof...(Methods);
+
+        static constexpr std::array<std::string_view, size> names = {Methods::name...};
+
+    private:
+        static constexpr bool has_unique_names() {
+            for (size_t i = 0; i < size; ++i) {
+                for (size_t j = i + 1; j < size; ++j) {
+                    if (names[i] == names[j]) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        static_assert(has_unique_names(), "Duplicate method name in StaticRegistry");
+
+        static constexpr detail::PerfectHash<size> hash = detail::PerfectHash<size>::build(names);
+
+        static_assert(hash.found, "Failed to build a perfect hash for the method names");
+
+    public:
+        // 查找方法下标，不存在时返回 -1；可在编译期求值
+        static constexpr int index_of(std::string_view name) {
+            uint16_t slot = hash.slots[hash.slot_of(name)];
+            if (slot == 0 || names[slot - 1] != name) {
+                return -1;
+            }
+            return slot - 1;
+        }
+
+        static constexpr bool contains(std::string_view name) {
+            return index_of(name) >= 0;
+        }
+
+        // 按名称调用，参数按位置传递，类型必须与处理函数匹配
+        template<typename Ret, typename... Args>
+        static Ret call(std::string_view name, Args&&... args) {
+            using Thunk = Ret(*)(Args&&...);
+            static constexpr Thunk thunks[] = {&positional_thunk<Methods, Ret, Args...>...};
+            return thunks[checked_index(name)](std::forward<Args>(args)...);
+        }
+
+        // 按名称调用，参数以 JSON 命名参数传递
+        template<typename Ret>
+        static Ret call_named(std::string_view name, const nlohmann::json& named_args) {
+            using Thunk = Ret(*)(const nlohmann::json&);
+            static constexpr Thunk thunks[] = {&named_thunk<Methods, Ret>...};
+            return thunks[checked_index(name)](named_args);
+        }
+
+    private:
+        static size_t checked_index(std::string_view name) {
+            int index = index_of(name);
+            if (index < 0) {
+                throw RpcException(
+                    RpcException::ErrorType::FUNCTION_NOT_FOUND,
+                    "Function not found: " + std::string(name)
+                );
+            }
+            return static_cast<size_t>(index);
+        }
+
+        template<typename Method, typename Ret>
+        static RpcException return_type_mismatch() {
+            using Traits = detail::function_traits<std::decay_t<decltype(Method::func)>>;
+            return RpcException(
+                RpcException::ErrorType::TYPE_MISMATCH,
+                "Return type mismatch. Expected " +
+                demangle(typeid(typename Traits::return_type).name()) +
+                " but got " + demangle(typeid(Ret).name())
+            );
+        }
+
+        template<typename Method, typename Ret, typename... Args>
+        static Ret positional_thunk(Args&&... args) {
+            using Traits = detail::function_traits<std::decay_t<decltype(Method::func)>>;
+            if constexpr (std::is_same_v<typename Traits::return_type, Ret> &&
+                          std::is_invocable_v<decltype(Method::func), Args&&...>) {
+                return Method::func(std::forward<Args>(args)...);
+            } else if constexpr (!std::is_same_v<typename Traits::return_type, Ret>) {
+                throw return_type_mismatch<Method, Ret>();
+            } else {
+                throw RpcException(
+                    RpcException::ErrorType::ARGUMENT_ERROR,
+                    "Arguments do not match function: " + std::string(Method::name)
+                );
+            }
+        }
+
+        template<typename Method, typename Ret>
+        static Ret named_thunk(const nlohmann::json& named_args) {
+            using Traits = detail::function_traits<std::decay_t<decltype(Method::func)>>;
+            if constexpr (std::is_same_v<typename Traits::return_type, Ret>) {
+                return invoke_named<Method, Ret, typename Traits::args_tuple>(
+                    named_args, std::make_index_sequence<Traits::arity>{}
+                );
+            } else {
+                throw return_type_mismatch<Method, Ret>();
+            }
+        }
+
+        // 每个方法的参数名索引，第一次按命名参数调用时构建
+        template<typename Method>
+        static const detail::ParamIndex& param_index() {
+            static const detail::ParamIndex index(std::vector<std::string>(Method::params.begin(), Method::params.end()));
+            return index;
+        }
+
+        // 遍历一次命名参数对象，每个键只查一次参数名索引
+        template<typename Method, typename Ret, typename ArgTuple, size_t... I>
+        static Ret invoke_named(const nlohmann::json& named_args, std::index_sequence<I...>) {
+            std::array<const nlohmann::json*, sizeof...(I)> values{};
+            if (named_args.is_object()) {
+                const detail::ParamIndex& index = param_index<Method>();
+                for (auto it = named_args.begin(); it != named_args.end(); ++it) {
+                    int i = index.find(it.key());
+                    if (i >= 0) {
+                        values[static_cast<size_t>(i)] = &*it;
+                    }
+                }
+            }
+            for (size_t i = 0; i < values.size(); ++i) {
+                if (!values[i]) {
+                    throw RpcException(
+                        RpcException::ErrorType::ARGUMENT_ERROR,
+                        "Missing argument: " + std::string(Method::params[i])
+                    );
+                }
+            }
+            try {
+                return Method::func(
+                    values[I]->template get<std::decay_t<std::tuple_element_t<I, ArgTuple>>>()...
+                );
+            } catch (const nlohmann::json::exception& e) {
+                throw RpcException(
+                    RpcException::ErrorType::TYPE_MISMATCH,
+                    "JSON conversion error for function '" + std::string(Method::name) + "': " + e.what()
+                );
+            }
+        }
+    };
+}
+
+// 声明一个静态方法：Tag 为生成的类型名，其余参数与 REGISTER_FUNCTION 相同；
+// 参数名的个数必须与函数的参数个数一致
+#define RPC_STATIC_METHOD(Tag, method_name, function, ...) \
+    struct Tag { \
+        static constexpr std::string_view name = method_name; \
+        static constexpr auto func = &function; \
+        static constexpr size_t arity = rpc::detail::function_traits<std::decay_t<decltype(func)>>::arity; \
+        static_assert(rpc::detail::count_param_names(#__VA_ARGS__) == arity, \
+                      "Parameter name count does not match the arity of " #function); \
+        static constexpr auto params = rpc::detail::split_param_names<arity>(#__VA_ARGS__); \
+    }
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef __RPC_STREAM_DESERIALIZER_H__
+#define __RPC_STREAM_DESERIALIZER_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <typeinfo>
+#include <vector>
+#include "serialization.hpp"
+
+namespace rpc {
+namespace serialization {
+    // 流式反序列化：数据分块到达时逐块 feed，try_deserialize 在数据足够时解码下一个值。
+    //
+    //   StreamDeserializer stream;
+    //   stream.feed(chunk);
+    //   uint32_t id;
+    //   if (!stream.try_deserialize(id)) { /* 至少还需要 stream.needed() 字节 */ }
+    //
+    // 数据不完整时不消费任何字节；下次 feed 的数据达到 needed() 之前不会重新尝试解码。
+    // 每次重试都从值的开头重新解码，needed() 只是下界：
+    //   - 数值、字符串、POD_BLOB 的长度前缀给出确切的缺少字节数，最多重试一次，总开销与长度成线性关系；
+    //   - LIST / MAP / 结构体只知道当前元素缺少多少字节，最坏情况下每到达一个元素重试一次，
+    //     总开销与元素个数成平方关系。
+    // 已知消息总长度时（例如 frame.hpp 的帧头）应先收齐整个帧再用 Deserializer 解码，
+    // ServerSession 就是这样做的；本类用于没有外层长度的流。
+    // 第一个字节为 COMPACT_MARKER 时整个流按紧凑编码解码。
+    class StreamDeserializer {
+    public:
+        explicit StreamDeserializer(size_t max_buffered_bytes = 64 * 1024 * 1024)
+            : max_buffered_bytes_(max_buffered_bytes) {}
+
+        void feed(ByteSpan chunk) {
+            if (buffered() + chunk.size() > max_buffered_bytes_) {
+                throw std::runtime_error("Stream buffer limit exceeded");
+            }
+            compact();
+            buffer_.insert(buffer_.end(), chunk.begin(), chunk.end());
+        }
+
+        // 成功时写入 out 并消费对应字节；数据不完整时返回 false，其他解码错误抛出异常
+        template<typename T>
+        bool try_deserialize(T& out) {
+            static_assert(!is_borrowed_v<T>, "StreamDeserializer cannot return views into its internal buffer");
+            if (!detect()) {
+                return false;
+            }
+            if (pending_type_ == &typeid(T) && buffered() < pending_bytes_) {
+                return false;
+            }
+
+            Deserializer in(ByteSpan(buffer_.data() + consumed_, buffered()), *format_);
+            try {
+                out = in.deserialize<T>();
+            } catch (const BufferUnderflow& e) {
+                pending_type_ = &typeid(T);
+                pending_bytes_ = buffered() + e.missing();
+                return false;
+            }
+            consumed_ += in.position();
+            pending_type_ = nullptr;
+            pending_bytes_ = 0;
+            return true;
+        }
+
+        // 上次解码失败后至少还需要的字节数（0 表示可以尝试解码）
+        size_t needed() const {
+            if (!format_) {
+                return 1;
+            }
+            return pending_bytes_ > buffered() ? pending_bytes_ - buffered() : 0;
+        }
+
+        // 已接收但尚未解码的字节数
+        size_t buffered() const { return buffer_.size() - consumed_; }
+
+        // 流的编码格式；收到第一个字节之前默认为 FIXED
+        WireFormat format() const { return format_.value_or(WireFormat::FIXED); }
+
+        // 丢弃所有数据，开始新的流
+        void reset() {
+            buffer_.clear();
+            consumed_ = 0;
+            format_.reset();
+            pending_type_ = nullptr;
+            pending_bytes_ = 0;
+        }
+
+    private:
+        std::vector<uint8_t> buffer_;
+        size_t consumed_ = 0;
+        size_t max_buffered_bytes_;
+        std::optional<WireFormat> format_;
+        const std::type_info* pending_type_ = nullptr;
+        size_t pending_bytes_ = 0;
+
+        // 根据第一个字节确定格式并跳过紧凑编码标记
+        bool detect() {
+            if (format_) {
+                return true;
+            }
+            if (buffered() == 0) {
+                return false;
+            }
+            format_ = detect_format(ByteSpan(buffer_.data() + consumed_, buffered()));
+            if (*format_ == WireFormat::COMPACT) {
+                ++consumed_;
+            }
+            return true;
+        }
+
+        // 已解码的部分超过一半时把剩余数据移到开头，避免缓冲区无限增长
+        void compact() {
+            if (consumed_ > 0 && consumed_ * 2 >= buffer_.size()) {
+                buffer_.erase(buffer_.begin(), buffer_.begin() + consumed_);
+                consumed_ = 0;
+            }
+        }
+    };
+}
+}
+
+#endif
@@ -1,4 +1,4 @@
-#include "serialization.hpp"
+#include "serializable.hpp"
 #include <iostream>
 
 void print_buffer(const std::vector<uint8_t>& buffer) {
@@ -18,34 +18,8 @@ struct Point {
     std::string name;
 };
 
-// 为Point实现序列化
-template<>
-struct rpc::serialization::Serializer<Point> {
-    static constexpr bool is_serializable = true;
-    
-    static size_t get_size(const Point& p) {
-        return sizeof(p.x) + sizeof(p.y) + sizeof(size_t) + p.name.size();
-    }
-    
-    static void serialize(std::vector<uint8_t>& buffer, const Point& p) {
-        size_t old_size = buffer.size();
-        size_t name_len = p.name.size();
-        buffer.resize(old_size + sizeof(p.x) + sizeof(p.y) + sizeof(size_t) + name_len);
-        
-        // 写入x和y
-        memcpy(buffer.data() + old_size, &p.x, sizeof(p.x));
-        old_size += sizeof(p.x);
-        
-        memcpy(buffer.data() + old_size, &p.y, sizeof(p.y));
-        old_size += sizeof(p.y);
-        
-        // 写入name
-        memcpy(buffer.data() + old_size, &name_len, sizeof(size_t));
-        old_size += sizeof(size_t);
-        
-        memcpy(buffer.data() + old_size, p.name.data(), name_len);
-    }
-};
+// 为Point生成序列化代码
+RPC_SERIALIZABLE(Point, x, y, name)
 
 int main() {
     // 测试基础类型
@@ -0,0 +1,98 @@
+#ifndef __RPC_THREAD_POOL_H__
+#define __RPC_THREAD_POOL_H__
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rpc {
+    // 固定大小的工作线程池，任务队列有深度上限
+    class ThreadPool {
+    public:
+        using Task = std::function<void()>;
+
+        // 默认线程数：CPU 核数
+        static size_t default_thread_count() {
+            return std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+
+        ThreadPool(size_t thread_count, size_t max_queue_depth)
+            : max_queue_depth_(max_queue_depth) {
+            if (thread_count == 0) {
+                thread_count = 1;
+            }
+            workers_.reserve(thread_count);
+            for (size_t i = 0; i < thread_count; ++i) {
+                workers_.emplace_back([this]() { worker_loop(); });
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // 析构时执行完队列中剩余的任务后再退出
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            cv_.notify_all();
+            for (auto& worker : workers_) {
+                worker.join();
+            }
+        }
+
+        // 提交任务，队列已满时返回 false 而不是阻塞调用方
+        bool try_submit(Task task) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (stopping_ || tasks_.size() >= max_queue_depth_) {
+                    return false;
+                }
+                tasks_.push_back(std::move(task));
+            }
+            cv_.notify_one();
+            return true;
+        }
+
+        size_t thread_count() const { return workers_.size(); }
+        size_t max_queue_depth() const { return max_queue_depth_; }
+
+        // 当前排队（尚未开始执行）的任务数
+        size_t queue_depth() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return tasks_.size();
+        }
+
+    private:
+        void worker_loop() {
+            for (;;) {
+                Task task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    cv_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+                    if (tasks_.empty()) {
+                        return;
+                    }
+                    task = std::move(tasks_.front());
+                    tasks_.pop_front();
+                }
+                task();
+            }
+        }
+
+        const size_t max_queue_depth_;
+        std::vector<std::thread> workers_;
+        std::deque<Task> tasks_;
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        bool stopping_ = false;
+    };
+}
+
+#endif
@@ -0,0 +1,236 @@
+#ifndef __RPC_UNIX_SOCKET_H__
+#define __RPC_UNIX_SOCKET_H__
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <utility>
+#include "event_loop.hpp"
+#include "span.hpp"
+
+// Unix 域套接字传输：帧格式与 TCP 相同，另外允许把大请求的负载放进 memfd，
+// 只发送帧头并通过 SCM_RIGHTS 传递描述符（见 frame.hpp 的 frame_descriptor_flag）。
+// 服务端只接受已经封印（不能再写入或改变大小）的 memfd，映射后内容不会再变
+namespace rpc {
+namespace net {
+    // 一次 recvmsg 最多接收的描述符个数
+    inline constexpr size_t max_descriptors_per_read = 16;
+
+    // 负载描述符要求的封印
+    inline constexpr int payload_seals = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE;
+
+    inline sockaddr_un make_unix_address(const std::string& path) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+            throw std::system_error(EINVAL, std::generic_category(), "Invalid Unix socket path: " + path);
+        }
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        return address;
+    }
+
+    // path 上的套接字文件是否已经没有进程在监听（连接被拒绝）
+    inline bool is_stale_unix_socket(const sockaddr_un& address) {
+        int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (probe < 0) {
+            return false;
+        }
+        bool refused = connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0 &&
+                       errno == ECONNREFUSED;
+        close(probe);
+        return refused;
+    }
+
+    // 非阻塞监听套接字。path 上残留的旧套接字文件会被删除；
+    // 仍有服务器在监听（或无法确认没有）时抛出 EADDRINUSE，不抢占它的路径
+    inline int open_unix_listener(const std::string& path, int backlog) {
+        sockaddr_un address = make_unix_address(path);
+        struct stat st;
+        if (lstat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+            if (!is_stale_unix_socket(address)) {
+                throw std::system_error(EADDRINUSE, std::generic_category(), "Unix socket in use: " + path);
+            }
+            unlink(path.c_str());
+        }
+        int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            throw_errno("socket");
+        }
+        if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            close(fd);
+            throw_errno("bind");
+        }
+        if (listen(fd, backlog) < 0) {
+            close(fd);
+            throw_errno("listen");
+        }
+        return fd;
+    }
+
+    inline int connect_unix(const std::string& path) {
+        sockaddr_un address = make_unix_address(path);
+        int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            throw_errno("socket");
+        }
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            int error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "connect");
+        }
+        return fd;
+    }
+
+    inline bool write_at(int fd, ByteSpan data, off_t offset) {
+        for (size_t written = 0; written < data.size();) {
+            ssize_t n = pwrite(fd, data.data() + written, data.size() - written, offset + static_cast<off_t>(written));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            written += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    // 把 prefix 和 body 依次写入一个新的 memfd 并封印，返回描述符。
+    // 用 pwrite 直接填充 tmpfs 页，比 mmap 后逐页缺页写入快
+    inline int make_payload_descriptor(ByteSpan prefix, ByteSpan body) {
+        int fd = memfd_create("rpc_payload", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+        if (fd < 0) {
+            throw_errno("memfd_create");
+        }
+        if (!write_at(fd, prefix, 0) || !write_at(fd, body, static_cast<off_t>(prefix.size()))) {
+            int error = errno ? errno : EIO;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "pwrite");
+        }
+        if (fcntl(fd, F_ADD_SEALS, payload_seals) < 0) {
+            int error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "fcntl(F_ADD_SEALS)");
+        }
+        return fd;
+    }
+
+    // 服务端映射的负载，析构时解除映射并关闭描述符
+    class MappedPayload {
+    public:
+        MappedPayload() = default;
+
+        // 检查封印和大小后只读映射前 size 字节；不符合要求时返回 false
+        bool map(int fd, size_t size) {
+            fd_ = fd;
+            int seals = fcntl(fd, F_GET_SEALS);
+            struct stat st;
+            if (seals < 0 || (seals & payload_seals) != payload_seals || fstat(fd, &st) < 0 ||
+                static_cast<uint64_t>(st.st_size) < size) {
+                return false;
+            }
+            if (size > 0) {
+                void* base = mmap(nullptr, size, PROT_READ, MAP_SHARED | MAP_POPULATE, fd, 0);
+                if (base == MAP_FAILED) {
+                    return false;
+                }
+                data_ = static_cast<const uint8_t*>(base);
+            }
+            size_ = size;
+            return true;
+        }
+
+        MappedPayload(const MappedPayload&) = delete;
+        MappedPayload& operator=(const MappedPayload&) = delete;
+
+        ~MappedPayload() {
+            if (data_) munmap(const_cast<uint8_t*>(data_), size_);
+            if (fd_ >= 0) close(fd_);
+        }
+
+        ByteSpan bytes() const { return ByteSpan(data_, size_); }
+
+    private:
+        int fd_ = -1;
+        const uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+    };
+
+    // 发送 data，同时用 SCM_RIGHTS 传递 fd
+    inline void send_with_descriptor(int socket_fd, ByteSpan data, int fd) {
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+        iovec io{const_cast<uint8_t*>(data.data()), data.size()};
+        msghdr message{};
+        message.msg_iov = &io;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        cmsghdr* header = CMSG_FIRSTHDR(&message);
+        header->cmsg_level = SOL_SOCKET;
+        header->cmsg_type = SCM_RIGHTS;
+        header->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(header), &fd, sizeof(int));
+
+        ssize_t n;
+        do {
+            n = sendmsg(socket_fd, &message, MSG_NOSIGNAL);
+        } while (n < 0 && errno == EINTR);
+        if (n < 0) {
+            throw_errno("sendmsg");
+        }
+        // 描述符随第一个字节发出，剩余部分按普通数据发送
+        for (size_t sent = static_cast<size_t>(n); sent < data.size();) {
+            n = send(socket_fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                throw_errno("send");
+            }
+            sent += static_cast<size_t>(n);
+        }
+    }
+
+    // recvmsg 读取数据，随数据到达的描述符依次交给 on_descriptor(int)。
+    // 返回值同 recv；控制消息被截断（描述符丢失）时返回 -1，errno 为 EPROTO
+    template<typename OnDescriptor>
+    ssize_t receive_with_descriptors(int socket_fd, span<uint8_t> buffer, OnDescriptor on_descriptor) {
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * max_descriptors_per_read)];
+        iovec io{buffer.data(), buffer.size()};
+        msghdr message{};
+        message.msg_iov = &io;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        ssize_t n = recvmsg(socket_fd, &message, MSG_CMSG_CLOEXEC);
+        if (n < 0) {
+            return n;
+        }
+        for (cmsghdr* header = CMSG_FIRSTHDR(&message); header; header = CMSG_NXTHDR(&message, header)) {
+            if (header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_RIGHTS) {
+                size_t count = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+                for (size_t i = 0; i < count; ++i) {
+                    int fd;
+                    std::memcpy(&fd, CMSG_DATA(header) + i * sizeof(int), sizeof(int));
+                    on_descriptor(fd);
+                }
+            }
+        }
+        if (message.msg_flags & MSG_CTRUNC) {
+            errno = EPROTO;
+            return -1;
+        }
+        return n;
+    }
+}
+}
+
+#endif
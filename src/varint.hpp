@@ -0,0 +1,136 @@
+#ifndef __RPC_VARINT_H__
+#define __RPC_VARINT_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include "serialization_error.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace rpc {
+namespace serialization {
+    // LEB128 变长整数：每字节 7 位数据，最高位表示后面还有字节。
+    // 有符号数先做 zig-zag 变换，让绝对值小的负数也只占很少的字节。
+    namespace varint {
+        // 编码后的最大字节数
+        template<typename T>
+        constexpr size_t max_bytes() {
+            return (sizeof(T) * 8 + 6) / 7;
+        }
+
+        template<typename T>
+        constexpr std::make_unsigned_t<T> zigzag_encode(T value) {
+            using U = std::make_unsigned_t<T>;
+            if constexpr (std::is_signed_v<T>) {
+                return (static_cast<U>(value) << 1) ^ static_cast<U>(value >> (sizeof(T) * 8 - 1));
+            } else {
+                return value;
+            }
+        }
+
+        template<typename T>
+        constexpr T zigzag_decode(std::make_unsigned_t<T> value) {
+            if constexpr (std::is_signed_v<T>) {
+                return static_cast<T>((value >> 1) ^ (~(value & 1) + 1));
+            } else {
+                return value;
+            }
+        }
+
+        // 写入 out（至少 max_bytes<T>() 字节），返回写入的字节数
+        template<typename T>
+        size_t encode(T value, uint8_t* out) {
+            auto bits = zigzag_encode(value);
+            size_t n = 0;
+            while (bits >= 0x80) {
+                out[n++] = static_cast<uint8_t>(bits | 0x80);
+                bits >>= 7;
+            }
+            out[n++] = static_cast<uint8_t>(bits);
+            return n;
+        }
+
+        // 从 data 读取一个 T，返回消耗的字节数。
+        // 数据不完整、超过 max_bytes<T>()、超出 T 的取值范围或不是最短编码（多字节且最后一个字节为 0）时抛出异常
+        template<typename T>
+        size_t decode(const uint8_t* data, size_t size, T& value) {
+            using U = std::make_unsigned_t<T>;
+            constexpr size_t limit = max_bytes<T>();
+            uint64_t bits = 0;
+            for (size_t i = 0; i < limit; ++i) {
+                if (i >= size) {
+                    throw BufferUnderflow(1);
+                }
+                uint8_t byte = data[i];
+                bits |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+                if ((byte & 0x80) == 0) {
+                    // 同一个值只有一种编码：多字节编码的最后一个字节不能为 0
+                    if (i > 0 && byte == 0) {
+                        throw std::runtime_error("Varint overlong encoding");
+                    }
+                    // 最后一个字节的多余高位必须为 0
+                    if constexpr (sizeof(U) < sizeof(uint64_t)) {
+                        if ((bits >> (sizeof(U) * 8)) != 0) {
+                            throw std::runtime_error("Varint out of range");
+                        }
+                    } else if (i == limit - 1 && byte > 1) {
+                        throw std::runtime_error("Varint out of range");
+                    }
+                    value = zigzag_decode<T>(static_cast<U>(bits));
+                    return i + 1;
+                }
+            }
+            throw std::runtime_error("Varint too long");
+        }
+
+        // 批量解码 count 个 T（用于 VECTOR_UINT32 / VECTOR_SINT32 等），返回消耗的字节数。
+        // 16 字节中没有续位时（16 个值都小于 128）用 SSE2 一次展开，否则逐个解码。
+        template<typename T>
+        size_t decode_bulk(const uint8_t* data, size_t size, T* out, size_t count) {
+            size_t position = 0;
+            size_t index = 0;
+#if defined(__SSE2__)
+            if constexpr (sizeof(T) == sizeof(uint32_t)) {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i one = _mm_set1_epi32(1);
+                while (count - index >= 16 && size - position >= 16) {
+                    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+                    if (_mm_movemask_epi8(bytes) != 0) {
+                        // 有多字节的值：解码一个后重新尝试
+                        position += decode(data + position, size - position, out[index++]);
+                        continue;
+                    }
+                    __m128i lo16 = _mm_unpacklo_epi8(bytes, zero);
+                    __m128i hi16 = _mm_unpackhi_epi8(bytes, zero);
+                    __m128i words[4] = {
+                        _mm_unpacklo_epi16(lo16, zero), _mm_unpackhi_epi16(lo16, zero),
+                        _mm_unpacklo_epi16(hi16, zero), _mm_unpackhi_epi16(hi16, zero)
+                    };
+                    for (int k = 0; k < 4; ++k) {
+                        __m128i v = words[k];
+                        if constexpr (std::is_signed_v<T>) {
+                            // (v >> 1) ^ -(v & 1)
+                            v = _mm_xor_si128(_mm_srli_epi32(v, 1),
+                                              _mm_sub_epi32(zero, _mm_and_si128(v, one)));
+                        }
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + index + 4 * k), v);
+                    }
+                    index += 16;
+                    position += 16;
+                }
+            }
+#endif
+            for (; index < count; ++index) {
+                position += decode(data + position, size - position, out[index]);
+            }
+            return position;
+        }
+    }
+}
+}
+
+#endif
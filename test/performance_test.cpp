@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 #include <chrono>
 #include "math_ops.h"
+#include "rpc_provider.hpp"
+#include "rpc_client.hpp"
+#include "rpc_server.hpp"
+#include "shm_client.hpp"
+#include "shm_server.hpp"
 
 using namespace rpc::math;
 using namespace std::chrono;
@@ -50,6 +55,138 @@ TEST_F(PerformanceTest, DivisionPerformance) {
     EXPECT_LT(avg_time, 2.0) << "Average division time: " << avg_time << " microseconds";
 }
 
+// 对比内联执行与线程池执行的 RPC 调用开销
+class RpcCallPerformanceTest : public ::testing::Test {
+protected:
+    MathOps math_ops;
+    rpc::RpcProvider server;
+    const nlohmann::json args = {{"a", 1}, {"b", 2}};
+    const int iterations = 10000;
+
+    void SetUp() override {
+        std::function<int(int, int)> add = [this](int a, int b) { return math_ops.add(a, b); };
+        server.register_function("add_pooled", add, {"a", "b"});
+        server.register_function("add_inline", add, {"a", "b"},
+                                 std::chrono::milliseconds(0), rpc::ExecutionMode::INLINE);
+    }
+
+    double average_call_time(const std::string& name) {
+        auto start = high_resolution_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            server.call_function_named<int>(name, args);
+        }
+        auto end = high_resolution_clock::now();
+        return static_cast<double>(duration_cast<nanoseconds>(end - start).count()) / iterations / 1000.0;
+    }
+};
+
+TEST_F(RpcCallPerformanceTest, InlineVersusPooled) {
+    double pooled = average_call_time("add_pooled");
+    double inline_time = average_call_time("add_inline");
+
+    std::cout << "Pooled call: " << pooled << " us, inline call: " << inline_time << " us" << std::endl;
+    EXPECT_LT(inline_time, pooled);
+}
+
+// 对比 SAX 流式解码与先构建 DOM 再转换的开销（大数组参数）
+TEST(JsonDecodePerformanceTest, SaxVersusDom) {
+    rpc::RpcProvider server;
+    std::function<size_t(std::vector<int>)> count = [](std::vector<int> values) { return values.size(); };
+    server.register_function("count", count, {"values"},
+                             std::chrono::milliseconds(0), rpc::ExecutionMode::INLINE);
+
+    std::vector<int> values(20000);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<int>(i);
+    }
+    const std::string text = nlohmann::json{{"values", values}}.dump();
+    const int rounds = 10;
+
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        server.call_function_named<size_t>("count", nlohmann::json::parse(text));
+    }
+    auto dom = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+    start = high_resolution_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        server.call_function_json<size_t>("count", text);
+    }
+    auto sax = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+    std::cout << "DOM decode: " << dom / rounds << " us, SAX decode: " << sax / rounds << " us" << std::endl;
+    EXPECT_LT(sax, dom);
+}
+
+// 通过回环 TCP 连接的往返吞吐量（单连接、逐个请求）
+TEST(ServerPerformanceTest, LoopbackRequestsPerSecond) {
+    rpc::RpcProvider provider;
+    std::function<int(int, int)> add = [](int a, int b) { return a + b; };
+    rpc::FunctionId id = provider.register_function("add", add, {"a", "b"},
+                                                    std::chrono::milliseconds(0), rpc::ExecutionMode::INLINE);
+    rpc::ServerOptions options;
+    options.host = "127.0.0.1";
+    options.loop_count = 1;
+    rpc::RpcServer server(provider, options);
+    server.start();
+
+    rpc::RpcClient client("127.0.0.1", server.port());
+    const int requests = 5000;
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < requests; ++i) {
+        ASSERT_EQ(client.invoke<int>(id, i, 1), i + 1);
+    }
+    auto elapsed = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+    std::cout << "Loopback round trip: " << static_cast<double>(elapsed) / requests << " us, "
+              << static_cast<long long>(requests * 1e6 / std::max<long long>(elapsed, 1)) << " requests/s" << std::endl;
+}
+
+TEST(ShmPerformanceTest, SameHostRoundTrip) {
+    rpc::RpcProvider provider;
+    std::function<int(int, int)> add = [](int a, int b) { return a + b; };
+    rpc::FunctionId id = provider.register_function("add", add, {"a", "b"},
+                                                    std::chrono::milliseconds(0), rpc::ExecutionMode::INLINE);
+    rpc::ShmServer server(provider);
+    rpc::ShmClient client(rpc::net::ShmChannel::from_fd(dup(server.open_channel())));
+
+    const int requests = 20000;
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < requests; ++i) {
+        ASSERT_EQ(client.invoke<int>(id, i, 1), i + 1);
+    }
+    auto elapsed = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+
+    std::cout << "Shared-memory round trip: " << static_cast<double>(elapsed) / requests / 1000 << " us" << std::endl;
+}
+
+TEST(ServerPerformanceTest, UnixSocketLargeArguments) {
+    rpc::RpcProvider provider;
+    std::function<double(std::vector<double>)> sum = [](std::vector<double> values) {
+        double total = 0;
+        for (double v : values) total += v;
+        return total;
+    };
+    provider.register_function("sum", sum, {"values"}, std::chrono::milliseconds(0), rpc::ExecutionMode::INLINE);
+    rpc::ServerOptions options;
+    options.unix_path = "/tmp/rpc_performance_test_" + std::to_string(getpid()) + ".sock";
+    rpc::RpcServer server(provider, options);
+    server.start();
+
+    std::vector<double> values(1 << 20, 1.0);  // 8 MB
+    const int requests = 20;
+    for (size_t threshold : {size_t(0), rpc::RpcClient::default_descriptor_threshold}) {
+        rpc::RpcClient client = rpc::RpcClient::connect_unix(options.unix_path, threshold);
+        auto start = high_resolution_clock::now();
+        for (int i = 0; i < requests; ++i) {
+            ASSERT_EQ(client.invoke<double>("sum", values), static_cast<double>(values.size()));
+        }
+        auto elapsed = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+        std::cout << "8 MB argument over Unix socket (" << (threshold ? "memfd" : "copied") << "): "
+                  << static_cast<double>(elapsed) / requests << " us" << std::endl;
+    }
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,502 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include "rpc_provider.hpp"
+
+using json = nlohmann::json;
+using namespace rpc;
+
+int add(int a, int b) {
+    return a + b;
+}
+
+std::string greet(std::string name, int age) {
+    return "Hello, " + name + "! You are " + std::to_string(age) + " years old.";
+}
+
+class RpcProviderTest : public ::testing::Test {
+protected:
+    RpcProvider server{ExecutorOptions{2, 16}};
+
+    void SetUp() override {
+        REGISTER_FUNCTION(server, "add", add, a, b);
+        REGISTER_FUNCTION(server, "greet", greet, name, age);
+    }
+};
+
+TEST_F(RpcProviderTest, NamedCall) {
+    EXPECT_EQ(server.call_function_named<int>("add", json{{"a", 5}, {"b", 3}}), 8);
+    EXPECT_EQ(server.call_function_named<std::string>("greet", json{{"age", 25}, {"name", "Alice"}}),
+              "Hello, Alice! You are 25 years old.");
+}
+
+TEST_F(RpcProviderTest, Errors) {
+    try {
+        server.call_function_named<int>("missing", json::object());
+        FAIL();
+    } catch (const RpcException& e) {
+        EXPECT_EQ(e.type(), RpcException::ErrorType::FUNCTION_NOT_FOUND);
+    }
+    try {
+        server.call_function_named<int>("add", json{{"a", 5}});
+        FAIL();
+    } catch (const RpcException& e) {
+        EXPECT_EQ(e.type(), RpcException::ErrorType::ARGUMENT_ERROR);
+    }
+    try {
+        server.call_function_named<int>("add", json{{"a", "x"}, {"b", 3}});
+        FAIL();
+    } catch (const RpcException& e) {
+        EXPECT_EQ(e.type(), RpcException::ErrorType::TYPE_MISMATCH);
+    }
+}
+
+// 重复的参数名在注册时拒绝，而不是每次调用都报缺少参数
+TEST(RpcProviderRegisterTest, RejectsDuplicateParamNames) {
+    RpcProvider server{ExecutorOptions{1, 4}};
+    try {
+        server.register_function("add", std::function<int(int, int)>(add), {"a", "a"});
+        FAIL();
+    } catch (const RpcException& e) {
+        EXPECT_EQ(e.type(), RpcException::ErrorType::ARGUMENT_ERROR);
+    }
+    EXPECT_THROW(server.function_id("add"), RpcException);
+}
+
+// 注册函数在固定的工作线程上执行，而不是每次调用新建线程
+TEST(RpcProviderExecutorTest, ReusesWorkerThreads) {
+    RpcProvider server(ExecutorOptions{2, 16});
+    server.register_function("thread_id", std::function<std::string()>([]() {
+        std::ostringstream os;
+        os << std::this_thread::get_id();
+        return os.str();
+    }), {});
+
+    std::set<std::string> ids;
+    for (int i = 0; i < 50; ++i) {
+        ids.insert(server.call_function_named<std::string>("thread_id", json::object()));
+    }
+    EXPECT_EQ(server.executor().thread_count(), 2u);
+    EXPECT_LE(ids.size(), 2u);
+}
+
+// 队列已满时立即拒绝
+TEST(RpcProviderExecutorTest, RejectsWhenQueueFull) {
+    std::atomic<bool> release{false};
+    RpcProvider server(ExecutorOptions{1, 1});
+    server.register_function("block", std::function<int()>([&release]() {
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return 0;
+    }), {}, std::chrono::milliseconds(10));
+
+    // 第一个调用占用工作线程，第二个占满队列
+    EXPECT_THROW(server.call_function_named<int>("block", json::object()), RpcException);
+    EXPECT_THROW(server.call_function_named<int>("block", json::object()), RpcException);
+    try {
+        server.call_function_named<int>("block", json::object());
+        FAIL();
+    } catch (const RpcException& e) {
+        EXPECT_EQ(e.type(), RpcException::ErrorType::OVERLOAD_ERROR);
+    }
+    release = true;
+}
+
+// 超时后调用方在截止时间内返回，后台任务通过令牌观察到取消
+TEST(RpcProviderTimeoutTest, TimeoutDoesNotBlockCaller) {
+    std::atomic<bool> observed_cancel{false};
+    RpcProvider server(ExecutorOptions{1, 4});
+    server.register_function("slow_concat",
+        std::function<std::string(std::string, std::string, CancellationToken)>(
+            [&observed_cancel](std::string a, std::string b, CancellationToken token) {
+                auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+                while (std::chrono::steady_clock::now() < deadline) {
+                    if (token.is_cancelled()) {
+                        observed_cancel = true;
+                        break;
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                return a + b;
+            }),
+        {"str1", "str2"}, std::chrono::milliseconds(50));
+
+    auto start = std::chrono::steady_clock::now();
+    try {
+        server.call_function_named<std::string>("slow_concat", json{{"str1", "a"}, {"str2", "b"}});
+        FAIL();
+    } catch (const RpcException& e) {
+        EXPECT_EQ(e.type(), RpcException::ErrorType::TIMEOUT_ERROR);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+
+    for (int i = 0; i < 1000 && !observed_cancel; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(observed_cancel);
+}
+
+// 内联函数在调用线程上执行
+TEST(RpcProviderInlineTest, RunsOnCallingThread) {
+    RpcProvider server(ExecutorOptions{1, 4});
+    server.register_function("caller_thread", std::function<bool()>([caller = std::this_thread::get_id()]() {
+        return std::this_thread::get_id() == caller;
+    }), {}, std::chrono::milliseconds(0), ExecutionMode::INLINE);
+    REGISTER_INLINE_FUNCTION(server, "add", add, a, b);
+
+    EXPECT_TRUE(server.call_function_named<bool>("caller_thread", json::object()));
+    EXPECT_EQ(server.call_function_named<int>("add", json{{"a", 2}, {"b", 3}}), 5);
+}
+
+// 函数编号分发与请求对象
+TEST(RpcProviderIdTest, CallById) {
+    RpcProvider server(ExecutorOptions{1, 4});
+    FunctionId add_id = REGISTER_INLINE_FUNCTION(server, "add", add, a, b);
+    FunctionId greet_id = REGISTER_FUNCTION(server, "greet", greet, name, age);
+
+    EXPECT_NE(add_id, greet_id);
+    EXPECT_EQ(server.function_id("add"), add_id);
+    // 重新注册沿用原编号
+    EXPECT_EQ(REGISTER_INLINE_FUNCTION(server, "add", add, a, b), add_id);
+
+    EXPECT_EQ(server.call_by_id<int>(add_id, json{{"a", 1}, {"b", 2}}), 3);
+    EXPECT_EQ(server.call_request<int>(json{{"method", add_id}, {"params", {{"a", 4}, {"b", 5}}}}), 9);
+    EXPECT_EQ(server.call_request<std::string>(json{{"method", "greet"}, {"params", {{"name", "Bob"}, {"age", 3}}}}),
+              "Hello, Bob! You are 3 years old.");
+
+    try {
+        server.call_by_id<int>(42, json::object());
+        FAIL();
+    } catch (const RpcException& e) {
+        EXPECT_EQ(e.type(), RpcException::ErrorType::FUNCTION_NOT_FOUND);
+    }
+}
+
+// 参数包：小元组放在内联缓冲区，大元组退回堆分配
+TEST(ArgumentPackTest, InlineAndHeapStorage) {
+    using Small = std::tuple<int, std::string, std::vector<int>>;
+    using Large = std::tuple<std::array<char, 1024>, int>;
+    static_assert(ArgumentPack::fits_inline<Small>());
+    static_assert(!ArgumentPack::fits_inline<Large>());
+
+    auto offsets = ArgumentPack::slot_offsets<Small>();
+    ArgumentPack pack;
+    pack.emplace<Small>();
+    *static_cast<int*>(pack.slot(offsets[0])) = 7;
+    *static_cast<std::string*>(pack.slot(offsets[1])) = "seven";
+    EXPECT_EQ(std::get<0>(pack.get<Small>()), 7);
+    EXPECT_EQ(std::get<1>(pack.get<Small>()), "seven");
+
+    auto large_offsets = ArgumentPack::slot_offsets<Large>();
+    pack.emplace<Large>();
+    *static_cast<int*>(pack.slot(large_offsets[1])) = 42;
+    EXPECT_EQ(std::get<1>(pack.get<Large>()), 42);
+}
+
+size_t total_length(std::vector<std::string> words, std::vector<int> weights) {
+    size_t total = 0;
+    for (size_t i = 0; i < words.size() && i < weights.size(); ++i) {
+        total += words[i].size() * static_cast<size_t>(weights[i]);
+    }
+    return total;
+}
+
+// SAX 流式解码 JSON 文本
+TEST_F(RpcProviderTest, JsonTextCall) {
+    REGISTER_INLINE_FUNCTION(server, "total_length", total_length, words, weights);
+
+    EXPECT_EQ(server.call_function_json<int>("add", R"({"b": 3, "a": 5})"), 8);
+    EXPECT_EQ(server.call_function_json<std::string>("greet", R"({"name": "Alice", "age": 25.0})"),
+              "Hello, Alice! You are 25 years old.");
+    // 未知参数（包括嵌套结构）被忽略
+    EXPECT_EQ(server.call_function_json<size_t>("total_length",
+              R"({"extra": {"x": [1, {"y": null}]}, "words": ["ab", "cde"], "weights": [2, 1]})"), 7u);
+
+    auto expect_error = [this](const char* text, RpcException::ErrorType type) {
+        try {
+            server.call_function_json<int>("add", text);
+            FAIL() << text;
+        } catch (const RpcException& e) {
+            EXPECT_EQ(e.type(), type) << text << ": " << e.what();
+        }
+    };
+    expect_error(R"({"a": 5})", RpcException::ErrorType::ARGUMENT_ERROR);
+    expect_error(R"({"a": "x", "b": 1})", RpcException::ErrorType::TYPE_MISMATCH);
+    expect_error(R"({"a": [1], "b": 1})", RpcException::ErrorType::TYPE_MISMATCH);
+    expect_error(R"([1, 2])", RpcException::ErrorType::ARGUMENT_ERROR);
+    expect_error(R"({"a": 1, "b": )", RpcException::ErrorType::ARGUMENT_ERROR);
+
+    // 顶层的 null 不是参数对象，即使函数没有参数
+    server.register_function("answer", std::function<int()>([]() { return 42; }), {},
+                             std::chrono::milliseconds(0), ExecutionMode::INLINE);
+    EXPECT_EQ(server.call_function_json<int>("answer", "{}"), 42);
+    try {
+        server.call_function_json<int>("answer", "null");
+        FAIL() << "expected ARGUMENT_ERROR";
+    } catch (const RpcException& e) {
+        EXPECT_EQ(e.type(), RpcException::ErrorType::ARGUMENT_ERROR);
+    }
+}
+
+// 参数名索引
+TEST(ParamIndexTest, FindsEveryName) {
+    std::vector<std::string> names;
+    for (int i = 0; i < 20; ++i) {
+        names.push_back("param_" + std::to_string(i));
+    }
+    detail::ParamIndex index(names);
+    for (size_t i = 0; i < names.size(); ++i) {
+        EXPECT_EQ(index.find(names[i]), static_cast<int>(i));
+    }
+    EXPECT_EQ(index.find("param_"), -1);
+    EXPECT_EQ(index.find("param_20"), -1);
+    EXPECT_EQ(index.find(""), -1);
+    EXPECT_EQ(detail::ParamIndex().find("a"), -1);
+}
+
+struct Vec3 {
+    double x = 0;
+    double y = 0;
+    double z = 0;
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Vec3, x, y, z)
+
+// 每个参数按注册时生成的解码函数转换，支持嵌套容器、optional、variant 和结构体
+TEST(RpcProviderCodecTest, NestedAndStructTypes) {
+    RpcProvider server(ExecutorOptions{1, 4});
+    server.register_function("row_sums",
+        std::function<std::array<int, 3>(std::array<std::array<int, 3>, 3>)>(
+            [](std::array<std::array<int, 3>, 3> m) {
+                std::array<int, 3> sums{};
+                for (size_t i = 0; i < 3; ++i) {
+                    for (int v : m[i]) sums[i] += v;
+                }
+                return sums;
+            }),
+        {"matrix"}, std::chrono::milliseconds(0), ExecutionMode::INLINE);
+    server.register_function("describe",
+        std::function<std::string(std::optional<int>, std::variant<int, std::string>,
+                                  std::map<std::string, std::vector<int>>, Vec3)>(
+            [](std::optional<int> limit, std::variant<int, std::string> tag,
+               std::map<std::string, std::vector<int>> groups, Vec3 v) {
+                std::string out = limit ? std::to_string(*limit) : "none";
+                out += std::holds_alternative<int>(tag) ? "/int" : "/" + std::get<std::string>(tag);
+                out += "/" + std::to_string(groups.size());
+                out += "/" + std::to_string(static_cast<int>(v.x + v.y + v.z));
+                return out;
+            }),
+        {"limit", "tag", "groups", "point"});
+    server.register_function("unsupported",
+        std::function<int(std::shared_ptr<int>)>([](std::shared_ptr<int>) { return 0; }),
+        {"ptr"});
+
+    auto sums = server.call_function_named<std::array<int, 3>>(
+        "row_sums", json{{"matrix", {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}}});
+    EXPECT_EQ(sums, (std::array<int, 3>{6, 15, 24}));
+
+    EXPECT_EQ(server.call_function_named<std::string>("describe", json{
+        {"limit", nullptr}, {"tag", "t"}, {"groups", {{"a", {1}}, {"b", json::array()}}},
+        {"point", {{"x", 1}, {"y", 2}, {"z", 3}}}}), "none/t/2/6");
+    // SAX 路径对复杂类型回退到按参数构建子 DOM
+    EXPECT_EQ(server.call_function_json<std::string>("describe",
+        R"({"limit": 5, "tag": 1, "groups": {}, "point": {"x": 0, "y": 0, "z": 1}})"), "5/int/0/1");
+
+    // variant 按 JSON 值的类型选择备选类型：1.5 不会被截断成 int
+    server.register_function("kind", std::function<std::string(std::variant<int, double>)>(
+        [](std::variant<int, double> v) {
+            return std::holds_alternative<int>(v) ? "int:" + std::to_string(std::get<int>(v))
+                                                  : "double:" + std::to_string(std::get<double>(v));
+        }), {"v"}, std::chrono::milliseconds(0), ExecutionMode::INLINE);
+    EXPECT_EQ(server.call_function_named<std::string>("kind", json{{"v", 1.5}}), "double:1.500000");
+    EXPECT_EQ(server.call_function_named<std::string>("kind", json{{"v", 2}}), "int:2");
+    EXPECT_EQ(server.call_function_json<std::string>("kind", R"({"v": 2.5})"), "double:2.500000");
+
+    try {
+        server.call_function_named<int>("unsupported", json{{"ptr", 1}});
+        FAIL();
+    } catch (const RpcException& e) {
+        EXPECT_EQ(e.type(), RpcException::ErrorType::TYPE_MISMATCH);
+    }
+}
+
+double average(std::vector<double> values, std::string label) {
+    double sum = 0;
+    for (double v : values) sum += v;
+    return values.empty() ? 0.0 : sum / values.size() + static_cast<double>(label.size());
+}
+
+// 二进制调用：参数直接从 serialization 格式解码，返回值以 serialize_value 编码
+TEST_F(RpcProviderTest, BinaryCall) {
+    FunctionId average_id = REGISTER_FUNCTION(server, "average", average, values, label);
+
+    auto args = serialization::serialize(int32_t(2), int32_t(40));
+    auto reply = server.call_function_binary("add", args);
+    serialization::Deserializer result(reply);
+    EXPECT_EQ(result.deserialize<int32_t>(), 42);
+    EXPECT_TRUE(result.at_end());
+
+    auto avg_args = serialization::serialize(std::vector<double>{1.0, 2.0, 3.0}, std::string("ab"));
+    auto avg_reply = server.call_function_binary(average_id, avg_args);
+    EXPECT_DOUBLE_EQ(serialization::Deserializer(avg_reply).deserialize<double>(), 4.0);
+
+    // 容器参数和返回值
+    server.register_function("histogram",
+        std::function<std::map<std::string, int32_t>(std::vector<std::string>)>([](std::vector<std::string> words) {
+            std::map<std::string, int32_t> counts;
+            for (const auto& w : words) ++counts[w];
+            return counts;
+        }),
+        {"words"});
+    auto histogram = server.call_function_binary("histogram",
+        serialization::serialize(std::vector<std::string>{"a", "b", "a"}));
+    auto counts = serialization::Deserializer(histogram).deserialize<std::map<std::string, int32_t>>();
+    EXPECT_EQ(counts, (std::map<std::string, int32_t>{{"a", 2}, {"b", 1}}));
+
+    // 紧凑编码的请求得到紧凑编码的返回值
+    auto compact_reply = server.call_function_binary("add", serialization::serialize_compact(int32_t(-2), int32_t(40)));
+    serialization::Deserializer compact_result(compact_reply);
+    EXPECT_EQ(compact_result.format(), serialization::WireFormat::COMPACT);
+    EXPECT_EQ(compact_result.deserialize<int32_t>(), 38);
+    EXPECT_TRUE(compact_result.at_end());
+
+    // 多次调用的返回值追加到同一个缓冲区
+    std::vector<uint8_t> out;
+    FunctionId add_id = server.function_id("add");
+    server.call_function_binary(add_id, args, out);
+    server.call_function_binary(add_id, args, out);
+    serialization::Deserializer appended(out);
+    EXPECT_EQ(appended.deserialize<int32_t>(), 42);
+    EXPECT_EQ(appended.deserialize<int32_t>(), 42);
+    EXPECT_TRUE(appended.at_end());
+
+    // 类型不匹配、缺少参数、多余字节
+    try {
+        server.call_function_binary("add", serialization::serialize(2.0, int32_t(1)));
+        FAIL();
+    } catch (const RpcException& e) {
+        EXPECT_EQ(e.type(), RpcException::ErrorType::TYPE_MISMATCH);
+    }
+    try {
+        server.call_function_binary("add", serialization::serialize(int32_t(1)));
+        FAIL();
+    } catch (const RpcException& e) {
+        EXPECT_EQ(e.type(), RpcException::ErrorType::TYPE_MISMATCH);
+    }
+    try {
+        server.call_function_binary("add", serialization::serialize(int32_t(1), int32_t(2), int32_t(3)));
+        FAIL();
+    } catch (const RpcException& e) {
+        EXPECT_EQ(e.type(), RpcException::ErrorType::ARGUMENT_ERROR);
+    }
+}
+
+// 视图参数：直接引用请求缓冲区
+TEST(RpcProviderBinaryViewTest, ViewArguments) {
+    RpcProvider server(ExecutorOptions{1, 4});
+    const uint8_t* payload_begin = nullptr;
+    const uint8_t* payload_end = nullptr;
+    server.register_function("sum_view",
+        std::function<double(serialization::ArrayView<double>, std::string_view)>(
+            [&](serialization::ArrayView<double> values, std::string_view label) {
+                EXPECT_TRUE(values.borrowed());
+                EXPECT_GE(reinterpret_cast<const uint8_t*>(label.data()), payload_begin);
+                EXPECT_LT(reinterpret_cast<const uint8_t*>(label.data()), payload_end);
+                double sum = 0;
+                for (double v : values) sum += v;
+                return sum + static_cast<double>(label.size());
+            }),
+        {"values", "label"}, std::chrono::milliseconds(0), ExecutionMode::INLINE);
+    server.register_function("sum_pooled",
+        std::function<double(serialization::ArrayView<double>)>([](serialization::ArrayView<double> values) {
+            double sum = 0;
+            for (double v : values) sum += v;
+            return sum;
+        }),
+        {"values"});
+
+    // 前面留 3 字节使 double 数据按 8 字节对齐（3 + 1 字节类型 + 4 字节长度 = 8）
+    std::vector<uint8_t> buffer(3);
+    auto encoded = serialization::serialize(std::vector<double>{1.5, 2.5}, std::string("abc"));
+    buffer.insert(buffer.end(), encoded.begin(), encoded.end());
+    ByteSpan args = ByteSpan(buffer).subspan(3);
+    payload_begin = args.begin();
+    payload_end = args.end();
+
+    auto reply = server.call_function_binary("sum_view", args);
+    EXPECT_DOUBLE_EQ(serialization::Deserializer(reply).deserialize<double>(), 7.0);
+
+    auto pooled_args = serialization::serialize(std::vector<double>{1.0, 2.0});
+    auto pooled_reply = server.call_function_binary("sum_pooled", pooled_args);
+    EXPECT_DOUBLE_EQ(serialization::Deserializer(pooled_reply).deserialize<double>(), 3.0);
+}
+
+// pmr 参数从参数包的分配区分配，不经过默认资源
+TEST(RpcProviderArenaTest, PmrArgumentsUseArena) {
+    RpcProvider server(ExecutorOptions{1, 4});
+    auto handler = [](std::pmr::string name, std::pmr::vector<double> values) {
+        EXPECT_NE(name.get_allocator().resource(), std::pmr::get_default_resource());
+        EXPECT_EQ(name.get_allocator().resource(), values.get_allocator().resource());
+        double sum = 0;
+        for (double v : values) sum += v;
+        return std::string(name) + ":" + std::to_string(static_cast<int>(sum));
+    };
+    using Signature = std::string(std::pmr::string, std::pmr::vector<double>);
+    server.register_function("label_inline", std::function<Signature>(handler), {"name", "values"},
+                             std::chrono::milliseconds(0), ExecutionMode::INLINE);
+    server.register_function("label_pooled", std::function<Signature>(handler), {"name", "values"});
+
+    std::string name(100, 'n');
+    auto args = serialization::serialize(name, std::vector<double>(500, 2.0));
+    for (const char* function : {"label_inline", "label_pooled"}) {
+        auto reply = server.call_function_binary(function, args);
+        EXPECT_EQ(serialization::Deserializer(reply).deserialize<std::string>(), name + ":1000");
+    }
+}
+
+// 异步调用：内联函数同步完成，线程池中的函数完成时调用回调
+TEST(RpcProviderAsyncTest, CompletesOnWorkerThreads) {
+    RpcProvider provider(ExecutorOptions{2, 16});
+    FunctionId add = provider.register_function("add", std::function<int(int, int)>([](int a, int b) {
+        return a + b;
+    }), {"a", "b"}, std::chrono::milliseconds(0), ExecutionMode::INLINE);
+    FunctionId slow = provider.register_function("slow", std::function<int(int)>([](int delay_ms) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+        return delay_ms;
+    }), {"delay_ms"}, std::chrono::milliseconds(100));
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::pair<std::vector<uint8_t>, std::exception_ptr>> results;
+    auto done = [&](std::vector<uint8_t> result, std::exception_ptr error) {
+        std::lock_guard<std::mutex> lock(mutex);
+        results.emplace_back(std::move(result), error);
+        cv.notify_all();
+    };
+
+    // 内联函数同步完成，不调用回调
+    std::vector<uint8_t> out;
+    EXPECT_TRUE(provider.call_function_binary_async(add, serialization::serialize(2, 3), out, done));
+    EXPECT_EQ(serialization::Deserializer(out).deserialize<int>(), 5);
+    EXPECT_THROW(provider.call_function_binary_async(99, ByteSpan(), out, done), RpcException);
+
+    // 线程池中的函数：一个正常完成，一个超时
+    EXPECT_FALSE(provider.call_function_binary_async(slow, serialization::serialize(10), out, done));
+    EXPECT_FALSE(provider.call_function_binary_async(slow, serialization::serialize(400), out, done));
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&] { return results.size() == 2; }));
+    ASSERT_FALSE(results[0].second);
+    EXPECT_EQ(serialization::Deserializer(results[0].first).deserialize<int>(), 10);
+    try {
+        std::rethrow_exception(results[1].second);
+        FAIL() << "expected timeout";
+    } catch (const RpcException& e) {
+        EXPECT_EQ(e.type(), RpcException::ErrorType::TIMEOUT_ERROR);
+    }
+}
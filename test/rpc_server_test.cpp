@@ -0,0 +1,660 @@
+#include <gtest/gtest.h>
+#include <poll.h>
+#include <sys/resource.h>
+#include <atomic>
+#include <future>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include "rpc_client.hpp"
+#include "rpc_server.hpp"
+
+using namespace rpc;
+
+namespace {
+    int add(int a, int b) {
+        return a + b;
+    }
+
+    std::string greet(std::string name, int age) {
+        return "Hello, " + name + "! You are " + std::to_string(age) + " years old.";
+    }
+
+    // 连接到服务器的原始套接字，用于发送手工构造的帧
+    int connect_raw(uint16_t port) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address = net::make_address("127.0.0.1", port);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    std::vector<uint8_t> read_frame(int fd, uint32_t* request_id = nullptr) {
+        uint8_t header[net::frame_header_size];
+        if (recv(fd, header, sizeof(header), MSG_WAITALL) != static_cast<ssize_t>(sizeof(header))) {
+            return {};
+        }
+        if (request_id) {
+            *request_id = net::frame_request_id(header);
+        }
+        std::vector<uint8_t> payload(net::frame_payload_length(header));
+        recv(fd, payload.data(), payload.size(), MSG_WAITALL);
+        return payload;
+    }
+
+    // 不读响应，非阻塞地重复发送 frame，直到 500 ms 内都不可写（服务器停止了读取）或发出 limit 个帧。
+    // 返回完整发出的帧数，最后一个帧已发出的字节数留在 offset
+    size_t send_until_blocked(int fd, const std::vector<uint8_t>& frame, size_t limit, size_t& offset, bool& blocked) {
+        size_t frames = 0;
+        offset = 0;
+        blocked = false;
+        while (!blocked && frames < limit) {
+            ssize_t n = send(fd, frame.data() + offset, frame.size() - offset, MSG_DONTWAIT | MSG_NOSIGNAL);
+            if (n > 0) {
+                offset += static_cast<size_t>(n);
+                if (offset == frame.size()) {
+                    offset = 0;
+                    ++frames;
+                }
+            } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                pollfd writable{fd, POLLOUT, 0};
+                blocked = poll(&writable, 1, 500) == 0;
+            } else {
+                break;
+            }
+        }
+        return frames;
+    }
+}
+
+// 每个用例分别在 epoll 和 io_uring 后端上运行
+class RpcServerTest : public ::testing::TestWithParam<IoEngine> {
+protected:
+    RpcProvider provider{ExecutorOptions{2, 64}};
+    std::unique_ptr<RpcServer> server;
+    FunctionId add_id = 0;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+
+    void SetUp() override {
+        add_id = REGISTER_INLINE_FUNCTION(provider, "add", add, a, b);
+        REGISTER_FUNCTION(provider, "greet", greet, name, age);
+        provider.register_function("sum", std::function<double(std::vector<double>)>([](std::vector<double> values) {
+            double total = 0;
+            for (double v : values) total += v;
+            return total;
+        }), {"values"});
+        provider.register_function("fail", std::function<int()>([]() -> int {
+            throw std::logic_error("handler failed");
+        }), {}, std::chrono::milliseconds(0), ExecutionMode::INLINE);
+        provider.register_function("slow_concat", std::function<std::string(std::string, std::string, int)>(
+            [](std::string a, std::string b, int delay_ms) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+                return a + b;
+            }), {"a", "b", "delay_ms"});
+        // 等待测试放行；超时后照常返回，响应顺序错误时用例失败而不是挂起
+        provider.register_function("gated", std::function<int(int)>([released = released](int value) {
+            released.wait_for(std::chrono::seconds(5));
+            return value;
+        }), {"value"});
+
+        ServerOptions options;
+        options.host = "127.0.0.1";
+        options.loop_count = 2;
+        options.max_frame_bytes = 4 << 20;
+        options.io_engine = GetParam();
+        server = std::make_unique<RpcServer>(provider, options);
+        try {
+            server->start();
+        } catch (const std::system_error& e) {
+            GTEST_SKIP() << "I/O engine unavailable: " << e.what();
+        }
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(Engines, RpcServerTest, ::testing::Values(IoEngine::EPOLL, IoEngine::IO_URING),
+    [](const ::testing::TestParamInfo<IoEngine>& info) {
+        return info.param == IoEngine::EPOLL ? "Epoll" : "IoUring";
+    });
+
+TEST_P(RpcServerTest, CallsOverTcp) {
+    EXPECT_NE(server->port(), 0);
+    EXPECT_EQ(server->loop_count(), 2u);
+    EXPECT_EQ(server->io_engine(), GetParam());
+
+    RpcClient client("127.0.0.1", server->port());
+    EXPECT_EQ(client.invoke<int>("add", 2, 3), 5);
+    EXPECT_EQ(client.invoke<int>(add_id, -4, 10), 6);
+    EXPECT_EQ(client.invoke<std::string>("greet", std::string("Alice"), 25),
+              "Hello, Alice! You are 25 years old.");
+
+    // 大请求和大响应需要多次读写
+    std::vector<double> values(200000, 0.5);
+    EXPECT_DOUBLE_EQ(client.invoke<double>("sum", values), 100000.0);
+
+    // 紧凑编码的请求得到紧凑编码的响应
+    auto reply = client.call(add_id, serialization::serialize_compact(int32_t(40), int32_t(2)));
+    serialization::Deserializer in(reply);
+    EXPECT_EQ(in.format(), serialization::WireFormat::COMPACT);
+    EXPECT_EQ(in.deserialize<int32_t>(), 42);
+}
+
+TEST_P(RpcServerTest, ErrorResponses) {
+    RpcClient client("127.0.0.1", server->port());
+    try {
+        client.invoke<int>("missing");
+        FAIL() << "expected FUNCTION_NOT_FOUND";
+    } catch (const RpcException& e) {
+        EXPECT_EQ(e.type(), RpcException::ErrorType::FUNCTION_NOT_FOUND);
+    }
+    try {
+        client.invoke<int>("add", std::string("x"), 1);
+        FAIL() << "expected TYPE_MISMATCH";
+    } catch (const RpcException& e) {
+        EXPECT_EQ(e.type(), RpcException::ErrorType::TYPE_MISMATCH);
+    }
+    EXPECT_THROW(client.invoke<int>("fail"), std::runtime_error);
+
+    // 错误之后连接仍然可用
+    EXPECT_EQ(client.invoke<int>("add", 1, 1), 2);
+}
+
+// 一次写入多个请求帧，内联函数的响应按顺序返回并带回请求编号
+TEST_P(RpcServerTest, PipelinedFrames) {
+    int fd = connect_raw(server->port());
+    ASSERT_GE(fd, 0);
+    std::vector<uint8_t> requests;
+    for (int32_t i = 0; i < 10; ++i) {
+        net::encode_request(requests, add_id, serialization::serialize(i, i), 100 + i);
+    }
+    // 最后一个帧分两次发送，验证不完整的帧会等待剩余数据
+    size_t split = requests.size() - 5;
+    ASSERT_EQ(send(fd, requests.data(), split, 0), static_cast<ssize_t>(split));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_EQ(send(fd, requests.data() + split, 5, 0), 5);
+
+    for (int32_t i = 0; i < 10; ++i) {
+        uint32_t request_id = 0;
+        auto payload = read_frame(fd, &request_id);
+        ASSERT_FALSE(payload.empty());
+        EXPECT_EQ(request_id, static_cast<uint32_t>(100 + i));
+        EXPECT_EQ(payload[0], static_cast<uint8_t>(net::FrameStatus::OK));
+        ByteSpan body(payload.data() + 1, payload.size() - 1);
+        EXPECT_EQ(serialization::Deserializer(body).deserialize<int32_t>(), 2 * i);
+    }
+    close(fd);
+}
+
+// 超过 max_frame_bytes 的帧直接断开连接
+TEST_P(RpcServerTest, RejectsOversizedFrames) {
+    int fd = connect_raw(server->port());
+    ASSERT_GE(fd, 0);
+    uint8_t header[net::frame_header_size] = {};
+    serialization::byte_order::store(header, uint32_t(8 << 20));
+    ASSERT_EQ(send(fd, header, sizeof(header), 0), static_cast<ssize_t>(sizeof(header)));
+    uint8_t byte;
+    EXPECT_EQ(recv(fd, &byte, 1, 0), 0);
+    close(fd);
+}
+
+// 慢调用不阻塞同一连接上后发出的调用，响应按完成顺序到达：
+// 先发出的 gated 调用等到后发出的调用的响应都收到之后才放行
+TEST_P(RpcServerTest, OutOfOrderResponses) {
+    int fd = connect_raw(server->port());
+    ASSERT_GE(fd, 0);
+    std::vector<uint8_t> requests;
+    net::encode_request(requests, std::string("gated"), serialization::serialize(7), 1);
+    net::encode_request(requests, std::string("slow_concat"),
+                        serialization::serialize(std::string("fast"), std::string("!"), 0), 2);
+    net::encode_request(requests, add_id, serialization::serialize(1, 2), 3);
+    ASSERT_EQ(send(fd, requests.data(), requests.size(), 0), static_cast<ssize_t>(requests.size()));
+
+    std::set<uint32_t> first_two;
+    for (int i = 0; i < 2; ++i) {
+        uint32_t request_id = 0;
+        EXPECT_FALSE(read_frame(fd, &request_id).empty());
+        first_two.insert(request_id);
+    }
+    release.set_value();
+    EXPECT_EQ(first_two, (std::set<uint32_t>{2, 3}));
+
+    uint32_t request_id = 0;
+    auto payload = read_frame(fd, &request_id);
+    EXPECT_EQ(request_id, 1u);
+    ASSERT_FALSE(payload.empty());
+    ByteSpan body(payload.data() + 1, payload.size() - 1);
+    EXPECT_EQ(serialization::Deserializer(body).deserialize<int32_t>(), 7);
+    close(fd);
+}
+
+// 客户端发完请求后关闭写方向，仍能收到尚在线程池中执行的调用的响应，之后服务器关闭连接
+TEST_P(RpcServerTest, HalfCloseStillAnswers) {
+    int fd = connect_raw(server->port());
+    ASSERT_GE(fd, 0);
+    std::vector<uint8_t> requests;
+    net::encode_request(requests, std::string("gated"), serialization::serialize(7), 1);
+    net::encode_request(requests, add_id, serialization::serialize(1, 2), 2);
+    ASSERT_EQ(send(fd, requests.data(), requests.size(), 0), static_cast<ssize_t>(requests.size()));
+    ASSERT_EQ(shutdown(fd, SHUT_WR), 0);
+
+    uint32_t request_id = 0;
+    EXPECT_FALSE(read_frame(fd, &request_id).empty());
+    EXPECT_EQ(request_id, 2u);
+    // 服务器已经读到 EOF，gated 仍未返回
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    release.set_value();
+    auto payload = read_frame(fd, &request_id);
+    EXPECT_EQ(request_id, 1u);
+    ASSERT_FALSE(payload.empty());
+    ByteSpan body(payload.data() + 1, payload.size() - 1);
+    EXPECT_EQ(serialization::Deserializer(body).deserialize<int32_t>(), 7);
+    uint8_t byte;
+    EXPECT_EQ(recv(fd, &byte, 1, 0), 0);
+    close(fd);
+}
+
+TEST_P(RpcServerTest, ManyCallsInFlightOnOneConnection) {
+    RpcClient client("127.0.0.1", server->port());
+    // 不超过线程池队列深度（64），否则多出的请求得到 OVERLOAD_ERROR
+    std::vector<RpcClient::PendingCall<double>> calls;
+    for (int i = 0; i < 48; ++i) {
+        calls.push_back(client.invoke_async<double>("sum", std::vector<double>{double(i), 0.5}));
+    }
+    // 放弃一部分请求，它们的响应到达后被丢弃
+    for (int i = 0; i < 10; ++i) {
+        client.invoke_async<std::string>("slow_concat", std::string("x"), std::string("y"), 0);
+    }
+    for (int i = 47; i >= 0; --i) {
+        ASSERT_DOUBLE_EQ(calls[i].get(), i + 0.5);
+    }
+    EXPECT_EQ(client.invoke<std::string>("slow_concat", std::string("a"), std::string("b"), 0), "ab");
+}
+
+// 多个线程共用一个连接
+TEST_P(RpcServerTest, ThreadsShareOneConnection) {
+    RpcClient client("127.0.0.1", server->port());
+    std::atomic<int> correct{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 100; ++i) {
+                if (i % 10 == 0) {
+                    auto reply = client.invoke<std::string>("slow_concat", std::to_string(t), std::to_string(i), 1);
+                    correct += reply == std::to_string(t) + std::to_string(i);
+                } else {
+                    correct += client.invoke<int>(add_id, t, i) == t + i;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(correct.load(), 400);
+}
+
+TEST_P(RpcServerTest, ConcurrentClients) {
+    std::atomic<int> correct{0};
+    std::vector<std::thread> clients;
+    for (int t = 0; t < 4; ++t) {
+        clients.emplace_back([&, t]() {
+            RpcClient client("127.0.0.1", server->port());
+            for (int i = 0; i < 100; ++i) {
+                if (client.invoke<int>("add", t, i) == t + i) {
+                    ++correct;
+                }
+            }
+        });
+    }
+    for (auto& thread : clients) {
+        thread.join();
+    }
+    EXPECT_EQ(correct.load(), 400);
+}
+
+// AUTO 在 io_uring 初始化失败时退回 epoll；显式要求 io_uring 时报告错误
+TEST(RpcServerEngineTest, FallsBackToEpoll) {
+    RpcProvider provider(ExecutorOptions{1, 4});
+    REGISTER_INLINE_FUNCTION(provider, "add", add, a, b);
+
+    ServerOptions options;
+    options.host = "127.0.0.1";
+    options.loop_count = 1;
+    options.uring_buffer_count = 100;  // 不是 2 的幂，缓冲区环注册失败
+
+    RpcServer strict(provider, [&] { auto o = options; o.io_engine = IoEngine::IO_URING; return o; }());
+    EXPECT_THROW(strict.start(), std::system_error);
+
+    RpcServer server(provider, options);
+    server.start();
+    EXPECT_EQ(server.io_engine(), IoEngine::EPOLL);
+    RpcClient client("127.0.0.1", server.port());
+    EXPECT_EQ(client.invoke<int>("add", 20, 22), 42);
+}
+
+class UnixSocketServerTest : public ::testing::Test {
+protected:
+    RpcProvider provider{ExecutorOptions{1, 16}};
+    std::string path = "/tmp/rpc_server_test_" + std::to_string(getpid()) + ".sock";
+    std::unique_ptr<RpcServer> server;
+
+    void SetUp() override {
+        REGISTER_INLINE_FUNCTION(provider, "add", add, a, b);
+        provider.register_function("sum", std::function<double(std::vector<double>)>([](std::vector<double> values) {
+            double total = 0;
+            for (double v : values) total += v;
+            return total;
+        }), {"values"});
+
+        ServerOptions options;
+        options.unix_path = path;
+        options.max_frame_bytes = 16 << 20;
+        server = std::make_unique<RpcServer>(provider, options);
+        server->start();
+    }
+};
+
+TEST_F(UnixSocketServerTest, CallsOverUnixSocket) {
+    EXPECT_EQ(server->port(), 0);
+    EXPECT_EQ(server->io_engine(), IoEngine::EPOLL);
+
+    RpcClient client = RpcClient::connect_unix(path);
+    EXPECT_EQ(client.invoke<int>("add", 2, 3), 5);
+    // 8 MB 参数超过默认阈值，通过 memfd 传递
+    std::vector<double> values(1 << 20, 0.25);
+    EXPECT_DOUBLE_EQ(client.invoke<double>("sum", values), 262144.0);
+    EXPECT_EQ(client.invoke<int>("add", 4, 5), 9);
+
+    server->stop();
+    EXPECT_NE(access(path.c_str(), F_OK), 0);
+}
+
+TEST_F(UnixSocketServerTest, DescriptorFramesKeepOrderAndErrors) {
+    // 阈值为 1：除无参数调用外每个请求都走描述符
+    RpcClient client = RpcClient::connect_unix(path, 1);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(client.invoke<int>("add", i, 1), i + 1);
+    }
+    try {
+        client.invoke<int>("missing", 1);
+        FAIL() << "expected RpcException";
+    } catch (const RpcException& e) {
+        EXPECT_EQ(e.type(), RpcException::ErrorType::FUNCTION_NOT_FOUND);
+    }
+    EXPECT_EQ(client.invoke<double>("sum", std::vector<double>{1.5, 2.5}), 4.0);
+}
+
+// 路径上仍有服务器在监听时不抢占；没有进程监听的残留套接字文件被替换
+TEST_F(UnixSocketServerTest, KeepsLiveSocketPath) {
+    ServerOptions options;
+    options.unix_path = path;
+    RpcServer second(provider, options);
+    try {
+        second.start();
+        FAIL() << "expected EADDRINUSE";
+    } catch (const std::system_error& e) {
+        EXPECT_EQ(e.code().value(), EADDRINUSE);
+    }
+    RpcClient client = RpcClient::connect_unix(path);
+    EXPECT_EQ(client.invoke<int>("add", 1, 2), 3);
+
+    std::string stale = path + ".stale";
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address = net::make_unix_address(stale);
+    ASSERT_EQ(bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    close(fd);
+    int listener = net::open_unix_listener(stale, 1);
+    EXPECT_GE(listener, 0);
+    close(listener);
+    unlink(stale.c_str());
+}
+
+// 未封印的 memfd 可能在映射后被对端截断，服务器直接断开连接
+TEST_F(UnixSocketServerTest, AcceptsOnlySealedDescriptors) {
+    int fd = net::connect_unix(path);
+    std::vector<uint8_t> payload;
+    net::encode_request(payload, std::string("add"), serialization::serialize(1, 2));
+    payload.erase(payload.begin(), payload.begin() + net::frame_header_size);
+    uint8_t header[net::frame_header_size];
+    serialization::byte_order::store(header, static_cast<uint32_t>(payload.size()) | net::frame_descriptor_flag);
+
+    int sealed = net::make_payload_descriptor(payload, ByteSpan());
+    net::send_with_descriptor(fd, ByteSpan(header), sealed);
+    close(sealed);
+    auto reply = read_frame(fd);
+    ASSERT_EQ(reply.size(), 1 + serialization::serialize(3).size());
+    EXPECT_EQ(reply[0], static_cast<uint8_t>(net::FrameStatus::OK));
+
+    int unsealed = memfd_create("unsealed", MFD_CLOEXEC);
+    ASSERT_EQ(write(unsealed, payload.data(), payload.size()), static_cast<ssize_t>(payload.size()));
+    net::send_with_descriptor(fd, ByteSpan(header), unsealed);
+    close(unsealed);
+
+    EXPECT_TRUE(read_frame(fd).empty());
+    close(fd);
+}
+
+TEST(RpcServerEngineTest, DescriptorFramesNeedUnixSocket) {
+    RpcProvider provider(ExecutorOptions{1, 4});
+    ServerOptions options;
+    options.host = "127.0.0.1";
+    options.loop_count = 1;
+    options.io_engine = IoEngine::EPOLL;
+    RpcServer server(provider, options);
+    server.start();
+
+    int fd = connect_raw(server.port());
+    uint8_t header[net::frame_header_size];
+    serialization::byte_order::store(header, 16u | net::frame_descriptor_flag);
+    ASSERT_EQ(send(fd, header, sizeof(header), MSG_NOSIGNAL), static_cast<ssize_t>(sizeof(header)));
+    EXPECT_TRUE(read_frame(fd).empty());
+    close(fd);
+
+    ServerOptions uring = options;
+    uring.unix_path = "/tmp/rpc_server_test_uring_" + std::to_string(getpid()) + ".sock";
+    uring.io_engine = IoEngine::IO_URING;
+    EXPECT_THROW(RpcServer(provider, uring).start(), std::system_error);
+}
+
+// 每个连接只允许一个未完成的请求时，后续请求等前一个完成后才处理
+TEST(RpcServerEngineTest, InFlightLimitDefersRequests) {
+    RpcProvider provider(ExecutorOptions{2, 16});
+    provider.register_function("sleep", std::function<int(int)>([](int delay_ms) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+        return delay_ms;
+    }), {"delay_ms"});
+    ServerOptions options;
+    options.host = "127.0.0.1";
+    options.loop_count = 1;
+    options.max_in_flight = 1;
+    RpcServer server(provider, options);
+    server.start();
+
+    RpcClient client("127.0.0.1", server.port());
+    auto start = std::chrono::steady_clock::now();
+    auto slow = client.invoke_async<int>("sleep", 200);
+    auto fast = client.invoke_async<int>("sleep", 0);
+    EXPECT_EQ(fast.get(), 0);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(200));
+    EXPECT_EQ(slow.get(), 200);
+}
+
+// 未完成的调用达到上限时服务器停止读取：持续发送请求的对端最终被 TCP 流量控制阻塞，
+// 请求留在内核缓冲区而不是服务器内存中；调用完成后恢复读取，所有请求都得到处理
+TEST(RpcServerEngineTest, InFlightLimitStopsReading) {
+    for (IoEngine engine : {IoEngine::EPOLL, IoEngine::IO_URING}) {
+        SCOPED_TRACE(engine == IoEngine::EPOLL ? "Epoll" : "IoUring");
+        RpcProvider provider(ExecutorOptions{2, 16});
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        provider.register_function("hold", std::function<int(std::string)>([released](std::string data) {
+            released.wait();
+            return static_cast<int>(data.size());
+        }), {"data"});
+        ServerOptions options;
+        options.host = "127.0.0.1";
+        options.loop_count = 1;
+        options.max_in_flight = 1;
+        options.io_engine = engine;
+        RpcServer server(provider, options);
+        try {
+            server.start();
+        } catch (const std::system_error&) {
+            continue;  // 内核不支持 io_uring
+        }
+
+        int fd = connect_raw(server.port());
+        ASSERT_GE(fd, 0);
+        std::vector<uint8_t> frame;
+        net::encode_request(frame, std::string("hold"), serialization::serialize(std::string(64 * 1024, 'x')));
+        // 服务器一直读取时 64 MB 之内不会阻塞
+        size_t offset;
+        bool blocked;
+        size_t frames = send_until_blocked(fd, frame, 1024, offset, blocked);
+        EXPECT_TRUE(blocked);
+        EXPECT_LT(frames, 1024u);
+
+        release.set_value();
+        if (offset > 0) {
+            ASSERT_EQ(send(fd, frame.data() + offset, frame.size() - offset, MSG_NOSIGNAL),
+                      static_cast<ssize_t>(frame.size() - offset));
+            ++frames;
+        }
+        for (size_t i = 0; i < frames; ++i) {
+            auto payload = read_frame(fd);
+            ASSERT_EQ(payload.size(), 1 + serialization::serialize(int32_t(0)).size());
+            ByteSpan body(payload.data() + 1, payload.size() - 1);
+            ASSERT_EQ(serialization::Deserializer(body).deserialize<int32_t>(), 64 * 1024);
+        }
+        close(fd);
+    }
+}
+
+// 同步执行的函数不占用未完成调用的名额：对端只发请求不读响应时，积压的响应达到上限后同样停止读取
+TEST(RpcServerEngineTest, OutputLimitStopsReading) {
+    for (IoEngine engine : {IoEngine::EPOLL, IoEngine::IO_URING}) {
+        SCOPED_TRACE(engine == IoEngine::EPOLL ? "Epoll" : "IoUring");
+        RpcProvider provider(ExecutorOptions{2, 16});
+        provider.register_function("blob", std::function<std::string(std::string)>([](std::string data) {
+            return std::string(data.size(), 'y');
+        }), {"data"}, std::chrono::milliseconds(0), ExecutionMode::INLINE);
+        ServerOptions options;
+        options.host = "127.0.0.1";
+        options.loop_count = 1;
+        options.max_pending_output = 256 * 1024;
+        options.io_engine = engine;
+        RpcServer server(provider, options);
+        try {
+            server.start();
+        } catch (const std::system_error&) {
+            continue;  // 内核不支持 io_uring
+        }
+
+        int fd = connect_raw(server.port());
+        ASSERT_GE(fd, 0);
+        std::vector<uint8_t> frame;
+        net::encode_request(frame, std::string("blob"), serialization::serialize(std::string(16 * 1024, 'x')));
+        // 服务器一直读取时 64 MB 之内不会阻塞
+        size_t offset;
+        bool blocked;
+        size_t frames = send_until_blocked(fd, frame, 4096, offset, blocked);
+        EXPECT_TRUE(blocked);
+        EXPECT_LT(frames, 4096u);
+
+        // 读走响应后服务器恢复读取，缓冲的请求全部得到应答
+        auto expect_blob = [&] {
+            auto payload = read_frame(fd);
+            ASSERT_FALSE(payload.empty());
+            ByteSpan body(payload.data() + 1, payload.size() - 1);
+            ASSERT_EQ(serialization::Deserializer(body).deserialize<std::string>().size(), 16u * 1024);
+        };
+        for (size_t i = 0; i < frames; ++i) {
+            expect_blob();
+        }
+        if (offset > 0) {
+            ASSERT_EQ(send(fd, frame.data() + offset, frame.size() - offset, MSG_NOSIGNAL),
+                      static_cast<ssize_t>(frame.size() - offset));
+            expect_blob();
+        }
+        close(fd);
+    }
+}
+
+// 提交队列很小时，一轮完成事件中准备的 SQE 超过队列深度，需要中途提交，完成队列也会溢出
+TEST(RpcServerEngineTest, TinyUringUnderLoad) {
+    RpcProvider provider(ExecutorOptions{2, 64});
+    FunctionId add_id = REGISTER_INLINE_FUNCTION(provider, "add", add, a, b);
+    ServerOptions options;
+    options.host = "127.0.0.1";
+    options.loop_count = 1;
+    options.io_engine = IoEngine::IO_URING;
+    options.uring_entries = 2;
+    RpcServer server(provider, options);
+    try {
+        server.start();
+    } catch (const std::system_error& e) {
+        GTEST_SKIP() << "io_uring unavailable: " << e.what();
+    }
+
+    std::vector<std::thread> clients;
+    std::atomic<int> failures{0};
+    for (int c = 0; c < 8; ++c) {
+        clients.emplace_back([&, c] {
+            RpcClient client("127.0.0.1", server.port());
+            std::vector<RpcClient::PendingCall<int>> calls;
+            for (int i = 0; i < 64; ++i) {
+                calls.push_back(client.invoke_async<int>(add_id, c, i));
+            }
+            for (int i = 0; i < 64; ++i) {
+                if (calls[i].get() != c + i) {
+                    ++failures;
+                }
+            }
+        });
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+    EXPECT_EQ(failures.load(), 0);
+}
+
+// 描述符用尽时 epoll 后端接受并关闭排队的连接，而不是让它们卡在边沿触发的监听套接字上
+TEST(RpcServerEngineTest, ClosesConnectionsWhenOutOfDescriptors) {
+    RpcProvider provider(ExecutorOptions{1, 4});
+    FunctionId add_id = REGISTER_INLINE_FUNCTION(provider, "add", add, a, b);
+    ServerOptions options;
+    options.host = "127.0.0.1";
+    options.loop_count = 1;
+    options.io_engine = IoEngine::EPOLL;
+    RpcServer server(provider, options);
+    server.start();
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(fd, 0);
+    timeval timeout{2, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    rlimit saved;
+    ASSERT_EQ(getrlimit(RLIMIT_NOFILE, &saved), 0);
+    rlimit lowered = saved;
+    lowered.rlim_cur = 128;
+    ASSERT_EQ(setrlimit(RLIMIT_NOFILE, &lowered), 0);
+    std::vector<int> fillers;
+    for (int filler; (filler = dup(fd)) >= 0;) {
+        fillers.push_back(filler);
+    }
+
+    sockaddr_in address = net::make_address("127.0.0.1", server.port());
+    ASSERT_EQ(connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    uint8_t byte;
+    EXPECT_EQ(recv(fd, &byte, 1, 0), 0);
+    close(fd);
+
+    for (int filler : fillers) {
+        close(filler);
+    }
+    ASSERT_EQ(setrlimit(RLIMIT_NOFILE, &saved), 0);
+    RpcClient client("127.0.0.1", server.port());
+    EXPECT_EQ(client.invoke<int>(add_id, 2, 3), 5);
+}
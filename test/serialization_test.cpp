@@ -0,0 +1,607 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+#include "serializable.hpp"
+#include "stream_deserializer.hpp"
+
+using namespace rpc;
+
+// 手写 Serializer 的结构体：成员按带类型标识的格式依次写入
+struct Sample {
+    int32_t id = 0;
+    std::string label;
+    std::vector<double> weights;
+
+    bool operator==(const Sample& other) const {
+        return id == other.id && label == other.label && weights == other.weights;
+    }
+};
+
+template<>
+struct rpc::serialization::Serializer<Sample> {
+    static constexpr bool is_serializable = true;
+
+    static size_t get_size(const Sample& s) {
+        return get_total_size(s.id, s.label, s.weights);
+    }
+
+    static void serialize(std::vector<uint8_t>& buffer, const Sample& s) {
+        serialize_value(buffer, s.id);
+        serialize_value(buffer, s.label);
+        serialize_value(buffer, s.weights);
+    }
+
+    static Sample deserialize(Deserializer& in) {
+        Sample s;
+        s.id = in.deserialize<int32_t>();
+        s.label = in.deserialize<std::string>();
+        s.weights = in.deserialize<std::vector<double>>();
+        return s;
+    }
+};
+
+TEST(ArrayViewTest, AlignedAndUnalignedSources) {
+    alignas(8) uint8_t storage[1 + 3 * sizeof(double)] = {};
+    double values[3] = {1.0, 2.0, 3.0};
+
+    std::memcpy(storage, values, sizeof(values));
+    serialization::ArrayView<double> aligned(storage, 3);
+    EXPECT_TRUE(aligned.borrowed());
+    EXPECT_EQ(aligned.data(), reinterpret_cast<const double*>(storage));
+
+    std::memcpy(storage + 1, values, sizeof(values));
+    serialization::ArrayView<double> unaligned(storage + 1, 3);
+    EXPECT_FALSE(unaligned.borrowed());
+    EXPECT_EQ(unaligned.to_vector(), std::vector<double>({1.0, 2.0, 3.0}));
+
+    serialization::ArrayView<double> moved = std::move(unaligned);
+    EXPECT_EQ(moved[2], 3.0);
+    serialization::ArrayView<double> copied = moved;
+    EXPECT_NE(copied.data(), moved.data());
+    EXPECT_EQ(copied[1], 2.0);
+}
+
+// 默认构建中序列化路径不产生任何输出
+TEST(SerializationOutputTest, NoStdoutInHotPath) {
+    testing::internal::CaptureStdout();
+    testing::internal::CaptureStderr();
+    auto buffer = serialization::serialize(std::string("payload"), 1.0);
+    serialization::Deserializer in(buffer);
+    EXPECT_EQ(in.deserialize<std::string>(), "payload");
+    EXPECT_DOUBLE_EQ(in.deserialize<double>(), 1.0);
+    EXPECT_TRUE(testing::internal::GetCapturedStdout().empty());
+    EXPECT_TRUE(testing::internal::GetCapturedStderr().empty());
+}
+
+// 写入调用方缓冲区：追加到已有 vector 或写入定长内存
+TEST(SerializeIntoTest, CallerBuffers) {
+    std::vector<double> values{1.0, 2.0, 3.0};
+    auto expected = serialization::serialize(int32_t(5), std::string("abc"), values);
+
+    std::vector<uint8_t> buffer{0xAA};
+    serialization::serialize_into(buffer, int32_t(5), std::string("abc"), values);
+    ASSERT_EQ(buffer.size(), expected.size() + 1);
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), buffer.begin() + 1));
+
+    uint8_t raw[64];
+    size_t written = serialization::serialize_into(span<uint8_t>(raw), int32_t(5), std::string("abc"), values);
+    ASSERT_EQ(written, expected.size());
+    EXPECT_EQ(std::memcmp(raw, expected.data(), written), 0);
+
+    uint8_t small[8];
+    EXPECT_THROW(serialization::serialize_into(span<uint8_t>(small), values), std::runtime_error);
+}
+
+// 分散/聚集输出：大负载直接引用原始内存
+TEST(GatherListTest, ReferencesLargePayloads) {
+    std::vector<uint32_t> large(1024, 7);
+    std::string small = "tiny";
+    serialization::GatherList gather(256);
+    gather.append(int64_t(42), small, large, 1.5);
+
+    auto expected = serialization::serialize(int64_t(42), small, large, 1.5);
+    EXPECT_EQ(gather.size_bytes(), expected.size());
+    EXPECT_EQ(gather.flatten(), expected);
+    EXPECT_EQ(gather.external_segments(), 1u);
+
+    const auto& iov = gather.iovecs();
+    ASSERT_EQ(iov.size(), 3u);
+    EXPECT_EQ(iov[1].iov_base, static_cast<const void*>(large.data()));
+    EXPECT_EQ(iov[1].iov_len, large.size() * sizeof(uint32_t));
+
+    // 一次 writev 发出整条消息
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    ssize_t sent = writev(fds[1], iov.data(), static_cast<int>(iov.size()));
+    ASSERT_EQ(sent, static_cast<ssize_t>(expected.size()));
+    std::vector<uint8_t> received(expected.size());
+    size_t got = 0;
+    while (got < received.size()) {
+        ssize_t n = read(fds[0], received.data() + got, received.size() - got);
+        ASSERT_GT(n, 0);
+        got += static_cast<size_t>(n);
+    }
+    close(fds[0]);
+    close(fds[1]);
+    EXPECT_EQ(received, expected);
+
+    serialization::Deserializer in(received);
+    EXPECT_EQ(in.deserialize<int64_t>(), 42);
+    EXPECT_EQ(in.deserialize<std::string>(), small);
+    EXPECT_EQ(in.deserialize<std::vector<uint32_t>>(), large);
+    EXPECT_DOUBLE_EQ(in.deserialize<double>(), 1.5);
+
+    gather.clear();
+    EXPECT_EQ(gather.size_bytes(), 0u);
+    EXPECT_TRUE(gather.iovecs().empty());
+}
+
+// varint / zig-zag 边界值
+TEST(VarintTest, RoundTripLimits) {
+    uint8_t bytes[16];
+    auto round_trip = [&](auto value) {
+        using T = decltype(value);
+        size_t n = serialization::varint::encode(value, bytes);
+        EXPECT_LE(n, serialization::varint::max_bytes<T>());
+        T decoded{};
+        EXPECT_EQ(serialization::varint::decode(bytes, n, decoded), n);
+        EXPECT_EQ(decoded, value);
+        return n;
+    };
+    EXPECT_EQ(round_trip(int32_t(0)), 1u);
+    EXPECT_EQ(round_trip(int32_t(-1)), 1u);
+    EXPECT_EQ(round_trip(int32_t(63)), 1u);
+    EXPECT_EQ(round_trip(int32_t(-64)), 1u);
+    EXPECT_EQ(round_trip(uint32_t(127)), 1u);
+    EXPECT_EQ(round_trip(uint32_t(128)), 2u);
+    round_trip(std::numeric_limits<int16_t>::min());
+    round_trip(std::numeric_limits<uint16_t>::max());
+    round_trip(std::numeric_limits<int32_t>::min());
+    round_trip(std::numeric_limits<uint32_t>::max());
+    EXPECT_EQ(round_trip(std::numeric_limits<int64_t>::min()), 10u);
+    EXPECT_EQ(round_trip(std::numeric_limits<uint64_t>::max()), 10u);
+
+    // 截断、过长、超出范围、非最短编码
+    uint32_t value;
+    const uint8_t overlong_zero[] = {0x80, 0x00};
+    EXPECT_THROW(serialization::varint::decode(overlong_zero, sizeof(overlong_zero), value), std::runtime_error);
+    const uint8_t overlong_one[] = {0x81, 0x80, 0x00};
+    EXPECT_THROW(serialization::varint::decode(overlong_one, sizeof(overlong_one), value), std::runtime_error);
+    const uint8_t truncated[] = {0x80, 0x80};
+    EXPECT_THROW(serialization::varint::decode(truncated, sizeof(truncated), value), std::runtime_error);
+    const uint8_t too_long[] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x01};
+    EXPECT_THROW(serialization::varint::decode(too_long, sizeof(too_long), value), std::runtime_error);
+    const uint8_t out_of_range[] = {0xFF, 0xFF, 0xFF, 0xFF, 0x1F};
+    EXPECT_THROW(serialization::varint::decode(out_of_range, sizeof(out_of_range), value), std::runtime_error);
+    uint16_t small;
+    const uint8_t too_big_for_16[] = {0x80, 0x80, 0x04};
+    EXPECT_THROW(serialization::varint::decode(too_big_for_16, sizeof(too_big_for_16), small), std::runtime_error);
+}
+
+// 紧凑编码消息：由首字节标记识别，体积更小
+TEST(CompactFormatTest, RoundTripAndSize) {
+    std::vector<int32_t> signed_values;
+    std::vector<uint32_t> unsigned_values;
+    for (int i = 0; i < 200; ++i) {
+        // 大部分是小值，穿插多字节值以覆盖批量解码的回退路径
+        signed_values.push_back(i % 37 == 0 ? -100000 * i : (i % 2 ? -i % 50 : i % 60));
+        unsigned_values.push_back(i % 29 == 0 ? 4000000000u - i : uint32_t(i % 100));
+    }
+    std::vector<int64_t> wide{0, -1, std::numeric_limits<int64_t>::max()};
+    std::vector<double> doubles{0.5, -2.25};
+    std::string text(300, 'x');
+
+    auto fixed = serialization::serialize(int32_t(-3), uint64_t(7), text, signed_values, unsigned_values, wide, doubles);
+    auto compact = serialization::serialize_compact(int32_t(-3), uint64_t(7), text, signed_values, unsigned_values, wide, doubles);
+    EXPECT_EQ(compact[0], serialization::COMPACT_MARKER);
+    EXPECT_LT(compact.size(), fixed.size() / 2);
+
+    serialization::Deserializer in(compact);
+    EXPECT_EQ(in.format(), serialization::WireFormat::COMPACT);
+    EXPECT_EQ(in.deserialize<int32_t>(), -3);
+    EXPECT_EQ(in.deserialize<uint64_t>(), 7u);
+    EXPECT_EQ(in.deserialize<std::string_view>(), text);
+    EXPECT_EQ(in.deserialize<std::vector<int32_t>>(), signed_values);
+    auto view = in.deserialize<serialization::ArrayView<uint32_t>>();
+    EXPECT_FALSE(view.borrowed());
+    EXPECT_EQ(view.to_vector(), unsigned_values);
+    EXPECT_EQ(in.deserialize<std::vector<int64_t>>(), wide);
+    EXPECT_EQ(in.deserialize<std::vector<double>>(), doubles);
+    EXPECT_TRUE(in.at_end());
+
+    EXPECT_EQ(serialization::Deserializer(fixed).format(), serialization::WireFormat::FIXED);
+
+    // 声明的元素个数超过剩余字节数
+    std::vector<uint8_t> bad{serialization::COMPACT_MARKER,
+                             static_cast<uint8_t>(serialization::DataType::VECTOR_UINT32), 0x05, 0x01};
+    serialization::Deserializer bad_in(bad);
+    EXPECT_THROW(bad_in.deserialize<std::vector<uint32_t>>(), std::runtime_error);
+}
+
+// 自动生成的 Serializer：逐成员编码
+struct Labelled {
+    float x = 0;
+    float y = 0;
+    std::string name;
+    std::vector<int32_t> tags;
+};
+RPC_SERIALIZABLE(Labelled, x, y, name, tags)
+
+// 平凡可复制且没有填充：整体 memcpy
+struct Pixel {
+    uint8_t r, g, b, a;
+    uint32_t depth;
+};
+RPC_SERIALIZABLE(Pixel, r, g, b, a, depth)
+
+// 有填充字节：不能整体复制，退回逐成员编码
+struct Padded {
+    uint8_t flag;
+    uint32_t value;
+};
+RPC_SERIALIZABLE(Padded, flag, value)
+
+// 指针成员的值不能跨进程传递，嵌套结构体自身有填充时也不能整体复制
+struct WithPointer {
+    uint64_t id;
+    const uint8_t* data;
+};
+RPC_SERIALIZABLE(WithPointer, id, data)
+
+struct HoldsPadded {
+    Padded inner;
+    uint64_t stamp;
+};
+RPC_SERIALIZABLE(HoldsPadded, inner, stamp)
+
+struct Segment {
+    Pixel from;
+    Pixel to;
+};
+RPC_SERIALIZABLE(Segment, from, to)
+
+TEST(SerializableMacroTest, GeneratedSerializers) {
+    static_assert(!serialization::Serializer<Labelled>::is_pod_layout);
+    static_assert(serialization::Serializer<Pixel>::is_pod_layout);
+    static_assert(!serialization::Serializer<Padded>::is_pod_layout);
+    static_assert(sizeof(WithPointer) == sizeof(uint64_t) + sizeof(const uint8_t*));
+    static_assert(!serialization::Serializer<WithPointer>::is_pod_layout);
+    static_assert(sizeof(HoldsPadded) == sizeof(Padded) + sizeof(uint64_t));
+    static_assert(!serialization::Serializer<HoldsPadded>::is_pod_layout);
+    static_assert(serialization::Serializer<Segment>::is_pod_layout);
+    static_assert(serialization::is_decodable_v<std::vector<Labelled>>);
+
+    Labelled labelled{1.5f, -2.0f, "origin", {1, 2, 3}};
+    Pixel pixel{1, 2, 3, 4, 0xDEADBEEF};
+    Padded padded{7, 99};
+
+    auto buffer = serialization::serialize(labelled, pixel, padded);
+    EXPECT_EQ(buffer.size(), serialization::get_total_size(labelled, pixel, padded));
+    // Pixel：类型标识 + 结构体原始字节
+    EXPECT_EQ(serialization::get_serialized_size(pixel), 1 + sizeof(Pixel));
+
+    for (const auto& bytes : {buffer, serialization::serialize_compact(labelled, pixel, padded)}) {
+        serialization::Deserializer in(bytes);
+        Labelled l = in.deserialize<Labelled>();
+        EXPECT_EQ(l.x, labelled.x);
+        EXPECT_EQ(l.y, labelled.y);
+        EXPECT_EQ(l.name, labelled.name);
+        EXPECT_EQ(l.tags, labelled.tags);
+        Pixel p = in.deserialize<Pixel>();
+        EXPECT_EQ(std::memcmp(&p, &pixel, sizeof(Pixel)), 0);
+        Padded d = in.deserialize<Padded>();
+        EXPECT_EQ(d.flag, 7);
+        EXPECT_EQ(d.value, 99u);
+        EXPECT_TRUE(in.at_end());
+    }
+}
+
+// 定长数组、嵌套容器、映射和结构体的完整往返
+TEST(DeserializerCoverageTest, ContainersAndStructs) {
+    std::array<int32_t, 3> fixed{1, -2, 3};
+    uint16_t raw[2] = {7, 65535};
+    std::array<std::string, 2> names{"a", "bc"};
+    std::vector<std::vector<int32_t>> nested{{1, 2}, {}, {-3}};
+    std::vector<std::string> words{"x", "", "yz"};
+    std::map<std::string, std::vector<int64_t>> groups{{"even", {0, 2}}, {"odd", {1}}};
+    std::unordered_map<uint32_t, std::string> lookup{{1, "one"}, {300, "three hundred"}};
+    Sample sample{42, "probe", {0.5, 1.5}};
+    std::vector<Sample> samples{sample, Sample{-1, "", {}}};
+
+    static_assert(serialization::is_encodable_v<decltype(groups)>);
+    static_assert(serialization::is_decodable_v<decltype(samples)>);
+    static_assert(!serialization::is_decodable_v<std::vector<std::string_view>>);
+
+    auto check = [&](const std::vector<uint8_t>& buffer) {
+        serialization::Deserializer in(buffer);
+        EXPECT_EQ(in.deserialize<decltype(fixed)>(), fixed);
+        uint16_t raw_out[2] = {};
+        in.deserialize_into(raw_out);
+        EXPECT_EQ(raw_out[0], 7);
+        EXPECT_EQ(raw_out[1], 65535);
+        EXPECT_EQ(in.deserialize<decltype(names)>(), names);
+        EXPECT_EQ(in.deserialize<decltype(nested)>(), nested);
+        EXPECT_EQ(in.deserialize<decltype(words)>(), words);
+        EXPECT_EQ(in.deserialize<decltype(groups)>(), groups);
+        EXPECT_EQ(in.deserialize<decltype(lookup)>(), lookup);
+        EXPECT_EQ(in.deserialize_value<Sample>(), sample);
+        EXPECT_EQ(in.deserialize<decltype(samples)>(), samples);
+        EXPECT_TRUE(in.at_end());
+    };
+
+    auto buffer = serialization::serialize(fixed, raw, names, nested, words, groups, lookup, sample, samples);
+    EXPECT_EQ(buffer.size(), serialization::get_total_size(fixed, raw, names, nested, words, groups, lookup, sample, samples));
+    check(buffer);
+    check(serialization::serialize_compact(fixed, raw, names, nested, words, groups, lookup, sample, samples));
+
+    // 元素个数不符、类型不符
+    auto short_buffer = serialization::serialize(std::array<int32_t, 2>{1, 2});
+    serialization::Deserializer short_array(short_buffer);
+    EXPECT_THROW(short_array.deserialize<decltype(fixed)>(), std::runtime_error);
+    auto words_buffer = serialization::serialize(words);
+    serialization::Deserializer wrong_tag(words_buffer);
+    EXPECT_THROW(wrong_tag.deserialize<decltype(groups)>(), std::runtime_error);
+    std::vector<uint8_t> huge_list{static_cast<uint8_t>(serialization::DataType::LIST), 0xFF, 0xFF, 0xFF, 0x0F, 11};
+    serialization::Deserializer huge(huge_list);
+    EXPECT_THROW(huge.deserialize<std::vector<std::string>>(), std::runtime_error);
+}
+
+// 平凡可复制结构体数组整块复制，并校验元素大小和布局
+struct Vertex {
+    float x, y, z;
+    uint32_t color;
+};
+RPC_SERIALIZABLE(Vertex, x, y, z, color)
+
+// 成员大小相同但类型不同：布局哈希不同
+struct VertexI {
+    int32_t x, y, z;
+    uint32_t color;
+};
+RPC_SERIALIZABLE(VertexI, x, y, z, color)
+
+TEST(PodBlobTest, VectorsOfTrivialStructs) {
+    static_assert(serialization::is_pod_blob_v<std::vector<Vertex>>);
+    static_assert(serialization::is_pod_blob_v<std::vector<std::array<float, 3>>>);
+    static_assert(!serialization::is_pod_blob_v<std::vector<Labelled>>);
+    static_assert(serialization::pod_layout_hash<Vertex>() != serialization::pod_layout_hash<VertexI>());
+
+    std::vector<Vertex> mesh;
+    for (uint32_t i = 0; i < 100; ++i) {
+        mesh.push_back(Vertex{float(i), float(i) * 2, -float(i), i});
+    }
+    std::vector<std::array<float, 3>> normals{{0, 0, 1}, {0, 1, 0}};
+    Vertex triangle[3] = {mesh[0], mesh[1], mesh[2]};
+
+    auto buffer = serialization::serialize(mesh, normals, triangle);
+    // 类型 + 个数 + 元素大小 + 哈希 + 数据
+    EXPECT_EQ(serialization::get_serialized_size(mesh), 1 + 4 + 4 + 8 + mesh.size() * sizeof(Vertex));
+    EXPECT_EQ(buffer.size(), serialization::get_total_size(mesh, normals, triangle));
+
+    serialization::Deserializer in(buffer);
+    auto decoded = in.deserialize<std::vector<Vertex>>();
+    ASSERT_EQ(decoded.size(), mesh.size());
+    EXPECT_EQ(std::memcmp(decoded.data(), mesh.data(), mesh.size() * sizeof(Vertex)), 0);
+    EXPECT_EQ(in.deserialize<decltype(normals)>(), normals);
+    Vertex triangle_out[3];
+    in.deserialize_into(triangle_out);
+    EXPECT_EQ(std::memcmp(triangle_out, triangle, sizeof(triangle)), 0);
+    EXPECT_TRUE(in.at_end());
+
+    // 零拷贝视图
+    serialization::Deserializer view_in(buffer);
+    auto view = view_in.deserialize<serialization::ArrayView<Vertex>>();
+    EXPECT_EQ(view.size(), mesh.size());
+    EXPECT_EQ(view[99].color, 99u);
+
+    // 分散/聚集输出直接引用数组内存
+    serialization::GatherList gather(64);
+    gather.append(mesh);
+    EXPECT_EQ(gather.external_segments(), 1u);
+    EXPECT_EQ(gather.flatten(), serialization::serialize(mesh));
+
+    // 布局不一致时拒绝解码
+    serialization::Deserializer mismatch(buffer);
+    EXPECT_THROW(mismatch.deserialize<std::vector<VertexI>>(), std::runtime_error);
+    serialization::Deserializer wrong_size(buffer);
+    using Normals = std::vector<std::array<float, 3>>;
+    EXPECT_THROW(wrong_size.deserialize<Normals>(), std::runtime_error);
+}
+
+// 字节序交换：SIMD 路径与标量路径结果一致
+TEST(ByteOrderTest, SwapCopyMatchesScalar) {
+    std::vector<uint8_t> source(8 * 101);
+    for (size_t i = 0; i < source.size(); ++i) {
+        source[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+    for (size_t element_size : {2u, 4u, 8u}) {
+        for (size_t count : {0u, 1u, 3u, 16u, 37u, 100u}) {
+            std::vector<uint8_t> expected(count * element_size);
+            std::vector<uint8_t> actual(count * element_size);
+            serialization::byte_order::swap_copy_scalar(expected.data(), source.data() + 1, count, element_size);
+            serialization::byte_order::swap_copy(actual.data(), source.data() + 1, count, element_size);
+            EXPECT_EQ(actual, expected) << "element size " << element_size << ", count " << count;
+
+            // 原地交换
+            std::vector<uint8_t> in_place(source.begin() + 1, source.begin() + 1 + count * element_size);
+            serialization::byte_order::swap_copy(in_place.data(), in_place.data(), count, element_size);
+            EXPECT_EQ(in_place, expected);
+
+#if RPC_BYTE_ORDER_X86
+            // 分别验证 SSSE3 路径（运行时选择的可能是 AVX2）
+            if (__builtin_cpu_supports("ssse3")) {
+                std::vector<uint8_t> ssse3(count * element_size);
+                size_t done = serialization::byte_order::swap_copy_ssse3(
+                    ssse3.data(), source.data() + 1, ssse3.size(), element_size);
+                EXPECT_TRUE(std::equal(ssse3.begin(), ssse3.begin() + done, expected.begin()));
+            }
+#endif
+        }
+    }
+    EXPECT_EQ(serialization::byte_order::byteswap(uint32_t(0x01020304)), 0x04030201u);
+    EXPECT_EQ(serialization::byte_order::byteswap(uint16_t(0xAABB)), 0xBBAA);
+    EXPECT_EQ(serialization::byte_order::byteswap(serialization::byte_order::byteswap(-1.25)), -1.25);
+}
+
+// 线路字节序固定为小端
+TEST(ByteOrderTest, WireIsLittleEndian) {
+    auto buffer = serialization::serialize(uint32_t(0x01020304), std::vector<uint16_t>{0x0A0B});
+    const std::vector<uint8_t> expected{
+        static_cast<uint8_t>(serialization::DataType::UINT32), 0x04, 0x03, 0x02, 0x01,
+        static_cast<uint8_t>(serialization::DataType::VECTOR_UINT16), 0x01, 0x00, 0x00, 0x00, 0x0B, 0x0A
+    };
+    EXPECT_EQ(buffer, expected);
+
+    serialization::Deserializer in(buffer);
+    EXPECT_EQ(in.deserialize<uint32_t>(), 0x01020304u);
+    EXPECT_EQ(in.deserialize<std::vector<uint16_t>>(), std::vector<uint16_t>{0x0A0B});
+}
+
+// 逐字节喂入：数据不完整时报告还需要的字节数，完整后解码且不多消费
+TEST(StreamDeserializerTest, ReportsMissingBytes) {
+    auto buffer = serialization::serialize(uint32_t(0xDEADBEEF), std::string("hello"));
+    serialization::StreamDeserializer stream;
+    EXPECT_EQ(stream.needed(), 1u);
+
+    uint32_t number = 0;
+    stream.feed(ByteSpan(buffer.data(), 1));
+    EXPECT_FALSE(stream.try_deserialize(number));
+    EXPECT_EQ(stream.needed(), 4u);
+    for (size_t i = 1; i < 5; ++i) {
+        stream.feed(ByteSpan(buffer.data() + i, 1));
+        EXPECT_EQ(stream.try_deserialize(number), i == 4);
+    }
+    EXPECT_EQ(number, 0xDEADBEEFu);
+    EXPECT_EQ(stream.buffered(), 0u);
+
+    std::string text;
+    stream.feed(ByteSpan(buffer.data() + 5, 5));
+    EXPECT_FALSE(stream.try_deserialize(text));
+    EXPECT_EQ(stream.needed(), 5u);
+    stream.feed(ByteSpan(buffer.data() + 10, buffer.size() - 10));
+    EXPECT_TRUE(stream.try_deserialize(text));
+    EXPECT_EQ(text, "hello");
+}
+
+// 大数组只收到头部时，按声明的长度报告缺少的数据，而不是逐字节重试
+TEST(StreamDeserializerTest, LargeMessagesAndCompactStreams) {
+    std::vector<double> values(1000, 1.5);
+    auto buffer = serialization::serialize(values);
+    serialization::StreamDeserializer stream;
+    stream.feed(ByteSpan(buffer.data(), 5));
+    std::vector<double> decoded;
+    EXPECT_FALSE(stream.try_deserialize(decoded));
+    EXPECT_EQ(stream.needed(), 8000u);
+
+    for (size_t offset = 5; offset < buffer.size(); offset += 997) {
+        size_t count = std::min<size_t>(997, buffer.size() - offset);
+        stream.feed(ByteSpan(buffer.data() + offset, count));
+        EXPECT_EQ(stream.try_deserialize(decoded), offset + count == buffer.size());
+    }
+    EXPECT_EQ(decoded, values);
+
+    // 紧凑编码的多个值分块到达
+    auto compact = serialization::serialize_compact(int64_t(-300), std::vector<uint32_t>{1, 200, 70000});
+    serialization::StreamDeserializer compact_stream;
+    int64_t signed_value = 0;
+    std::vector<uint32_t> list;
+    size_t fed = 0;
+    bool got_signed = false;
+    while (fed < compact.size()) {
+        size_t count = std::min<size_t>(2, compact.size() - fed);
+        compact_stream.feed(ByteSpan(compact.data() + fed, count));
+        fed += count;
+        if (!got_signed) {
+            got_signed = compact_stream.try_deserialize(signed_value);
+        }
+        if (got_signed && compact_stream.try_deserialize(list)) {
+            break;
+        }
+    }
+    EXPECT_EQ(compact_stream.format(), serialization::WireFormat::COMPACT);
+    EXPECT_EQ(signed_value, -300);
+    EXPECT_EQ(list, (std::vector<uint32_t>{1, 200, 70000}));
+}
+
+TEST(StreamDeserializerTest, ErrorsAndLimits) {
+    auto buffer = serialization::serialize(uint32_t(7));
+    serialization::StreamDeserializer stream;
+    stream.feed(buffer);
+    double wrong;
+    EXPECT_THROW(stream.try_deserialize(wrong), std::runtime_error);
+
+    serialization::StreamDeserializer limited(16);
+    std::vector<uint8_t> chunk(10);
+    limited.feed(chunk);
+    EXPECT_THROW(limited.feed(chunk), std::runtime_error);
+
+    // 头部声明的长度超过剩余数据时，一次性反序列化报告缺少的字节数
+    auto truncated = serialization::serialize(std::string(100, 'x'));
+    truncated.resize(20);
+    serialization::Deserializer in(truncated);
+    try {
+        in.deserialize<std::string>();
+        FAIL() << "expected BufferUnderflow";
+    } catch (const serialization::BufferUnderflow& e) {
+        EXPECT_EQ(e.missing(), 85u);
+    }
+}
+
+// 统计经过的分配次数
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// pmr 容器从 Deserializer 的内存资源分配，默认资源不参与解码
+TEST(PmrDecodeTest, DecodesIntoArena) {
+    std::map<std::string, std::vector<int32_t>> groups{{"a", {1, 2}}, {"long key outside sso", {3}}};
+    auto buffer = serialization::serialize(std::string(64, 's'), std::vector<double>{1.5, 2.5},
+                                           std::vector<std::string>{"x", std::string(40, 'y')}, groups);
+
+    CountingResource counting;
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(&counting);
+    {
+        alignas(std::max_align_t) unsigned char storage[256];
+        std::pmr::monotonic_buffer_resource arena(storage, sizeof(storage), std::pmr::new_delete_resource());
+        serialization::Deserializer in(buffer);
+        in.set_memory_resource(&arena);
+        auto text = in.deserialize<std::pmr::string>();
+        auto values = in.deserialize<std::pmr::vector<double>>();
+        auto words = in.deserialize<std::pmr::vector<std::pmr::string>>();
+        auto decoded_groups = in.deserialize<std::pmr::map<std::pmr::string, std::pmr::vector<int32_t>>>();
+        EXPECT_TRUE(in.at_end());
+        EXPECT_EQ(counting.allocations, 0u);
+
+        EXPECT_EQ(std::string_view(text), std::string(64, 's'));
+        EXPECT_EQ(values, (std::pmr::vector<double>{1.5, 2.5}));
+        ASSERT_EQ(words.size(), 2u);
+        EXPECT_EQ(std::string_view(words[1]), std::string(40, 'y'));
+        EXPECT_EQ(words[1].get_allocator().resource(), &arena);
+        EXPECT_EQ(decoded_groups.at("long key outside sso"), (std::pmr::vector<int32_t>{3}));
+        EXPECT_EQ(decoded_groups.begin()->second.get_allocator().resource(), &arena);
+
+        // pmr 容器按相同的线路格式编码
+        EXPECT_EQ(serialization::serialize(text, values), serialization::serialize(
+            std::string(64, 's'), std::vector<double>{1.5, 2.5}));
+    }
+    std::pmr::set_default_resource(previous);
+}
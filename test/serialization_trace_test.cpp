@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "serialization.hpp"
+
+using namespace rpc;
+
+namespace {
+    std::vector<serialization::TraceRecord> records;
+
+    void record_hook(const serialization::TraceRecord& record) {
+        records.push_back(record);
+    }
+}
+
+TEST(SerializationTraceTest, ReportsSizesAndTypes) {
+    records.clear();
+    serialization::TraceHook previous = serialization::set_trace_hook(&record_hook);
+
+    auto buffer = serialization::serialize(int32_t(7), std::string("hello"));
+    serialization::Deserializer in(buffer);
+    EXPECT_EQ(in.deserialize<int32_t>(), 7);
+    EXPECT_EQ(in.deserialize<std::string>(), "hello");
+
+    serialization::set_trace_hook(previous);
+
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0].event, serialization::TraceEvent::SERIALIZE);
+    EXPECT_STREQ(records[0].type, "message");
+    EXPECT_EQ(records[0].bytes, buffer.size());
+    EXPECT_GE(records[0].nanoseconds, 0);
+    EXPECT_EQ(records[1].event, serialization::TraceEvent::DESERIALIZE);
+    EXPECT_STREQ(records[1].type, "string");
+    EXPECT_EQ(records[1].bytes, 5u);
+}
+
+// 紧凑编码报告实际写入的字节数，而不是定长编码的估计值
+TEST(SerializationTraceTest, CompactReportsEncodedSize) {
+    records.clear();
+    serialization::TraceHook previous = serialization::set_trace_hook(&record_hook);
+    auto buffer = serialization::serialize_compact(int32_t(7), uint64_t(1));
+    serialization::set_trace_hook(previous);
+
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_STREQ(records[0].type, "compact message");
+    EXPECT_EQ(records[0].bytes, buffer.size());
+    EXPECT_LT(buffer.size(), serialization::serialize(int32_t(7), uint64_t(1)).size());
+}
+
+TEST(SerializationTraceTest, NullHookDropsRecords) {
+    records.clear();
+    serialization::TraceHook previous = serialization::set_trace_hook(nullptr);
+    testing::internal::CaptureStderr();
+    serialization::serialize(std::string("quiet"));
+    EXPECT_TRUE(testing::internal::GetCapturedStderr().empty());
+    serialization::set_trace_hook(previous);
+    EXPECT_TRUE(records.empty());
+}
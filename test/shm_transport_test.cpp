@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "shm_client.hpp"
+#include "shm_server.hpp"
+
+using namespace rpc;
+
+namespace {
+    int add(int a, int b) {
+        return a + b;
+    }
+
+    std::string greet(std::string name, int age) {
+        return "Hello, " + name + "! You are " + std::to_string(age) + " years old.";
+    }
+
+    // 服务器持有的通道描述符复制一份，相当于客户端进程继承或收到的描述符
+    ShmClient attach(int fd, ShmOptions options = ShmOptions()) {
+        return ShmClient(net::ShmChannel::from_fd(dup(fd)), options);
+    }
+}
+
+class ShmTransportTest : public ::testing::Test {
+protected:
+    RpcProvider provider{ExecutorOptions{2, 64}};
+    FunctionId add_id = 0;
+
+    void SetUp() override {
+        add_id = REGISTER_INLINE_FUNCTION(provider, "add", add, a, b);
+        REGISTER_FUNCTION(provider, "greet", greet, name, age);
+        provider.register_function("sum", std::function<double(std::vector<double>)>([](std::vector<double> values) {
+            double total = 0;
+            for (double v : values) total += v;
+            return total;
+        }), {"values"});
+        provider.register_function("repeat", std::function<std::string(std::string, int)>([](std::string s, int n) {
+            std::string out;
+            for (int i = 0; i < n; ++i) out += s;
+            return out;
+        }), {"s", "n"}, std::chrono::milliseconds(0), ExecutionMode::INLINE);
+        provider.register_function("fail", std::function<int()>([]() -> int {
+            throw std::logic_error("handler failed");
+        }), {}, std::chrono::milliseconds(0), ExecutionMode::INLINE);
+    }
+};
+
+TEST_F(ShmTransportTest, CallsThroughMemfdChannel) {
+    ShmServer server(provider);
+    ShmClient client = attach(server.open_channel());
+    EXPECT_EQ(server.channel_count(), 1u);
+
+    EXPECT_EQ(client.invoke<int>("add", 2, 3), 5);
+    EXPECT_EQ(client.invoke<int>(add_id, 40, 2), 42);
+    EXPECT_EQ(client.invoke<std::string>("greet", std::string("Ann"), 30), "Hello, Ann! You are 30 years old.");
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(client.invoke<int>(add_id, i, 1), i + 1);
+    }
+
+    try {
+        client.invoke<int>("missing");
+        FAIL() << "expected RpcException";
+    } catch (const RpcException& e) {
+        EXPECT_EQ(e.type(), RpcException::ErrorType::FUNCTION_NOT_FOUND);
+    }
+    EXPECT_THROW(client.invoke<int>("fail"), std::runtime_error);
+    EXPECT_EQ(client.invoke<int>("add", 1, 1), 2);
+}
+
+// 请求和响应都比环大得多，必须分段写入并跨越环尾
+TEST_F(ShmTransportTest, FramesLargerThanRing) {
+    ShmOptions options;
+    options.ring_bytes = 4096;
+    ShmServer server(provider, options);
+    ShmClient client = attach(server.open_channel(), options);
+
+    std::vector<double> values(100000, 0.5);
+    EXPECT_DOUBLE_EQ(client.invoke<double>("sum", values), 50000.0);
+    std::string reply = client.invoke<std::string>("repeat", std::string("abc"), 30000);
+    EXPECT_EQ(reply.size(), 90000u);
+    EXPECT_EQ(reply.substr(reply.size() - 3), "abc");
+    EXPECT_EQ(client.invoke<int>("add", 1, 2), 3);
+}
+
+TEST_F(ShmTransportTest, NamedChannelAndBusyPoll) {
+    ShmOptions options;
+    options.busy_poll = true;
+    ShmServer server(provider, options);
+    std::string name = "/rpc_shm_test_" + std::to_string(getpid());
+    server.open_channel(name);
+
+    ShmClient client(name, options);
+    for (int i = 0; i < 200; ++i) {
+        ASSERT_EQ(client.invoke<int>("add", i, i), 2 * i);
+    }
+    EXPECT_THROW(net::ShmChannel::create(4096, name), std::system_error);
+}
+
+TEST_F(ShmTransportTest, StoppedServerFailsCalls) {
+    ShmServer server(provider);
+    ShmClient client = attach(server.open_channel());
+    EXPECT_EQ(client.invoke<int>("add", 1, 2), 3);
+    server.stop();
+    EXPECT_THROW(client.invoke<int>("add", 1, 2), std::system_error);
+}
+
+// 客户端关闭通道后服务线程退出，通道随之回收
+TEST_F(ShmTransportTest, ReapsClosedChannels) {
+    ShmServer server(provider);
+    for (int i = 0; i < 3; ++i) {
+        ShmClient client = attach(server.open_channel());
+        EXPECT_EQ(client.invoke<int>("add", i, 1), i + 1);
+    }
+    ShmClient live = attach(server.open_channel());
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (server.channel_count() > 1 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(server.channel_count(), 1u);
+    EXPECT_EQ(live.invoke<int>("add", 2, 2), 4);
+}
+
+TEST(ShmChannelTest, RejectsForeignDescriptors) {
+    int fd = memfd_create("not_a_channel", MFD_CLOEXEC);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(ftruncate(fd, 65536), 0);
+    EXPECT_THROW(net::ShmChannel::from_fd(fd), std::system_error);
+}
+
+// 对端写坏共享的读写位置时不越界读写，按通道关闭处理
+TEST(ShmChannelTest, RejectsCorruptRingPositions) {
+    net::ShmRingHeader header;
+    std::vector<uint8_t> data(4096);
+    std::atomic<uint32_t> closed{0};
+    std::vector<uint8_t> bytes(data.size() + 1);
+    ShmOptions options;
+
+    // 生产方声称写入的数据比环还多
+    header.tail.store(data.size() + 1);
+    net::ShmRing reader(&header, data.data(), data.size(), &closed);
+    EXPECT_TRUE(reader.readable().empty());
+    EXPECT_TRUE(reader.closed());
+    EXPECT_FALSE(reader.wait_readable(options));
+
+    // 消费方的读位置跑到写位置前面
+    closed.store(0);
+    header.tail.store(0);
+    header.head.store(100);
+    net::ShmRing writer(&header, data.data(), data.size(), &closed);
+    EXPECT_EQ(writer.write_some(bytes), 0u);
+    EXPECT_TRUE(writer.closed());
+    EXPECT_FALSE(writer.write_all(bytes, options));
+    EXPECT_EQ(header.tail.load(), 0u);
+}
+
+// 两个线程通过一个很小的环传输字节流，检查顺序与内容
+TEST(ShmChannelTest, StreamsBytesInOrder) {
+    auto channel = net::ShmChannel::create(4096);
+    auto peer = net::ShmChannel::from_fd(dup(channel.fd()));
+    ShmOptions options;
+    const size_t total = 1 << 20;
+
+    std::thread producer([&] {
+        std::vector<uint8_t> chunk(1000);
+        for (size_t sent = 0; sent < total;) {
+            size_t count = std::min(chunk.size(), total - sent);
+            for (size_t i = 0; i < count; ++i) chunk[i] = static_cast<uint8_t>((sent + i) * 7);
+            ASSERT_TRUE(channel.requests().write_all(ByteSpan(chunk.data(), count), options));
+            sent += count;
+        }
+    });
+
+    std::vector<uint8_t> received(total);
+    ASSERT_TRUE(peer.requests().read_exact(received.data(), total, options));
+    producer.join();
+    for (size_t i = 0; i < total; ++i) {
+        ASSERT_EQ(received[i], static_cast<uint8_t>(i * 7)) << i;
+    }
+    EXPECT_TRUE(peer.requests().readable().empty());
+
+    channel.close();
+    EXPECT_FALSE(peer.requests().wait_readable(options));
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "static_registry.hpp"
+
+using json = nlohmann::json;
+using namespace rpc;
+
+namespace {
+    int add(int a, int b) {
+        return a + b;
+    }
+
+    std::string greet(std::string name, int age) {
+        return "Hello, " + name + "! You are " + std::to_string(age) + " years old.";
+    }
+
+    bool compare(int a, int b) {
+        return a > b;
+    }
+
+    RPC_STATIC_METHOD(AddMethod, "add", add, a, b);
+    RPC_STATIC_METHOD(GreetMethod, "greet", greet, name, age);
+    RPC_STATIC_METHOD(CompareMethod, "compare", compare, a, b);
+
+    using Service = StaticRegistry<AddMethod, GreetMethod, CompareMethod>;
+}
+
+TEST(StaticRegistryTest, CompileTimeLookup) {
+    static_assert(Service::index_of("add") == 0);
+    static_assert(Service::index_of("greet") == 1);
+    static_assert(Service::index_of("compare") == 2);
+    static_assert(!Service::contains("missing"));
+    static_assert(GreetMethod::params[1] == "age");
+    // RPC_STATIC_METHOD 用它检查参数名个数与函数参数个数一致
+    static_assert(detail::count_param_names("") == 0);
+    static_assert(detail::count_param_names(" a ") == 1);
+    static_assert(detail::count_param_names("a, b") == 2);
+    static_assert(detail::count_param_names("a,") == 2);
+}
+
+TEST(StaticRegistryTest, PositionalCall) {
+    EXPECT_EQ(Service::call<int>("add", 2, 3), 5);
+    EXPECT_TRUE(Service::call<bool>("compare", 10, 5));
+    EXPECT_EQ(Service::call<std::string>("greet", std::string("Alice"), 25),
+              "Hello, Alice! You are 25 years old.");
+}
+
+TEST(StaticRegistryTest, NamedCall) {
+    EXPECT_EQ(Service::call_named<int>("add", json{{"b", 3}, {"a", 5}}), 8);
+    EXPECT_EQ(Service::call_named<std::string>("greet", json{{"name", "Bob"}, {"age", 3}}),
+              "Hello, Bob! You are 3 years old.");
+    // 未知的键被忽略
+    EXPECT_EQ(Service::call_named<int>("add", json{{"a", 1}, {"extra", true}, {"b", 2}}), 3);
+}
+
+TEST(StaticRegistryTest, Errors) {
+    try {
+        Service::call<int>("missing", 1, 2);
+        FAIL();
+    } catch (const RpcException& e) {
+        EXPECT_EQ(e.type(), RpcException::ErrorType::FUNCTION_NOT_FOUND);
+    }
+    try {
+        Service::call<int>("greet", std::string("x"), 1);
+        FAIL();
+    } catch (const RpcException& e) {
+        EXPECT_EQ(e.type(), RpcException::ErrorType::TYPE_MISMATCH);
+    }
+    try {
+        Service::call_named<int>("add", json{{"a", 1}});
+        FAIL();
+    } catch (const RpcException& e) {
+        EXPECT_EQ(e.type(), RpcException::ErrorType::ARGUMENT_ERROR);
+    }
+}